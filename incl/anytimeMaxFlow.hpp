@@ -0,0 +1,42 @@
+#ifndef ANYTIMEMAXFLOW
+#define ANYTIMEMAXFLOW
+
+#include "boostGraphStruct.hpp"
+#include "flatNetwork.hpp"
+#include <vector>
+
+// result of an anytime solve. the max flow value is between lower and upper
+struct AnytimeBounds
+{
+    long long lower;        // value of the flow left in the network
+    long long upper;        // capacity of the smallest s-t cut seen
+    bool exact;             // the solver ran to the end, lower == upper
+    long long augmentations;
+    long long checks;       // times the upper bound was refreshed
+};
+
+/* Functions */
+
+// flatShortestAugmentedPath that stops as soon as (upper - lower) / upper <= epsilon.
+// the lower bound is the current flow value. the upper bound comes from the distance labels:
+// for every k <= d[s] the vertices with d[v] >= k are an s-t cut, and since the labels are valid
+// the only residual arcs leaving it are the admissible arcs from label k to k - 1, so one pass
+// over the arcs gives the capacity (flow + residual out) of all d[s] cuts at once. it is
+// refreshed every [checkEvery] iterations of the main loop, 0 picks the number of arcs so the
+// refresh costs about as much as the work between two of them. the partial flow stays in N
+void anytimeMaxFlow(FlatNetwork& N, int s, int t, double epsilon, AnytimeBounds& bounds, long long checkEvery = 0);
+
+// builds the flat network of G, solves it from zero flow and writes the partial flow back to G.
+// returns false if t is not reachable from s
+bool anytimeMaxFlow(Graph& G, Vertex s, Vertex t, double epsilon, AnytimeBounds& bounds);
+
+// smallest capacity of the cuts {v : d[v] >= k}, 1 <= k <= d[s], given the current flow value
+long long flatLabelCutBound(const FlatNetwork& N, int s, const BulkVector<int>& d, long long flow);
+
+// the epsilon used by the MaxFlowSolver version of anytimeMaxFlow
+void setAnytimeEpsilon(double epsilon);
+
+// MaxFlowSolver version: solves G to within the epsilon of setAnytimeEpsilon and prints the bounds
+bool anytimeMaxFlow(Graph& G, Vertex s, Vertex t);
+
+#endif
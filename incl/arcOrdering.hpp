@@ -0,0 +1,35 @@
+#ifndef ARCORDERING
+#define ARCORDERING
+
+#include "boostGraphStruct.hpp"
+#include <string>
+
+// orders in which the advance step of shortestAugmentedPath can meet the arcs of a vertex. SAP
+// takes the first admissible arc it finds, so an order that puts the likely admissible arcs first
+// scans fewer arcs per advance. by default the out edges and the in edges (the simulated reverse
+// arcs) are in the order the edges were added to G, and all out edges are tried before any in edge
+enum ArcOrder
+{
+    ARC_ORDER_NONE,         // insertion order
+    ARC_ORDER_DISTANCE,     // by the calcDist label of the other end, lowest first. the arcs to
+                            // d[i] - 1 are the admissible ones while the labels are still exact,
+                            // and vertices that cannot reach t go last
+    ARC_ORDER_CAPACITY,     // by capacity, largest first, so that the first paths carry the most
+    ARC_ORDER_INTERLEAVE    // lists unchanged, SAP alternates between out and in edges
+};
+
+/* Functions */
+
+// sorts the out edge and in edge lists of every vertex of G in place in [arcOrder]. the lists are
+// Boost's std::lists, so the sort only relinks their nodes: edge descriptors and the flow stay
+// valid and nothing has to be mapped back. ties keep their insertion order. ARC_ORDER_INTERLEAVE
+// only changes the scan of SAP, which main and microbench turn on with setInterleavedArcScan
+void orderArcs(Graph& G, Vertex t, ArcOrder arcOrder);
+
+// "none", "distance", "capacity" or "interleave"
+const char* arcOrderName(ArcOrder arcOrder);
+
+// the order called [name]. returns false for an unknown name
+bool parseArcOrder(const std::string& name, ArcOrder& arcOrder);
+
+#endif
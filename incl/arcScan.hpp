@@ -0,0 +1,38 @@
+#ifndef ARCSCAN
+#define ARCSCAN
+
+// the two inner loops of the shortest augmenting path algorithm over contiguous arc arrays.
+// both exist in a scalar, an AVX2 and an AVX-512 version. the version is picked at runtime
+// from what the cpu supports, the scalar one is always available
+
+// instruction sets the scans can run on
+enum ArcScanKernel
+{
+    SCAN_AUTO,      // widest one the cpu supports
+    SCAN_SCALAR,
+    SCAN_AVX2,
+    SCAN_AVX512
+};
+
+// returns the first arc a in [begin, end) with residual[a] > 0 and label[head[a]] == wanted, or end
+typedef int (*AdmissibleArcScan)(const int* head, const int* residual, const int* label, int begin, int end, int wanted);
+
+// returns the min label[head[a]] over the arcs a in [begin, end) with residual[a] > 0, or INT_MAX
+typedef int (*MinLabelScan)(const int* head, const int* residual, const int* label, int begin, int end);
+
+// the selected kernels
+extern AdmissibleArcScan admissibleArcScan;
+extern MinLabelScan minLabelScan;
+
+/* Functions */
+
+// selects the kernels. falls back to a narrower instruction set if the cpu does not support
+// the requested one and returns the kernel that was actually selected
+ArcScanKernel setArcScanKernel(ArcScanKernel kernel);
+
+// the kernel currently selected
+ArcScanKernel arcScanKernel();
+
+const char* arcScanKernelName(ArcScanKernel kernel);
+
+#endif
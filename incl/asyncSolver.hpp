@@ -0,0 +1,155 @@
+#ifndef ASYNCSOLVER
+#define ASYNCSOLVER
+
+#include "boostGraphStruct.hpp"
+#include "flatNetwork.hpp"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <thread>
+
+// progress of a running solve as seen by another thread
+struct SolveSnapshot
+{
+    long long flow;             // flow value so far
+    int sourceLabel;            // d[s]
+    long long iterations;       // advance and retreat steps so far
+    long long augmentations;
+    bool running;
+};
+
+// how an async solve ended
+enum SolveStatus
+{
+    SOLVE_DONE,                 // the flow is maximum
+    SOLVE_UNREACHABLE,          // t is not reachable from s
+    SOLVE_CANCELLED,            // cancel() was called. the flow is feasible but not maximum
+    SOLVE_DEADLINE              // the deadline passed. the flow is feasible but not maximum
+};
+
+// shared between the thread that started a solve and its worker. cancel, setDeadline and
+// progress can be called from any thread while the solve runs. the worker looks at the
+// cancel flag and the deadline every [checkEvery] iterations of the main loop, and publishes
+// a snapshot at the same time through a sequence counter, so readers never take a lock and
+// never block the worker. a reader that overlaps a publish retries.
+class SolveControl
+{
+public:
+    SolveControl(long long checkEvery = 4096);
+
+    void cancel();
+    void setDeadline(std::chrono::steady_clock::time_point deadline);
+
+    // the latest snapshot the worker published
+    SolveSnapshot progress() const;
+
+    // used by the worker
+
+    long long checkEvery() const { return every; }
+
+    // publishes a snapshot and returns false if the solve has to stop
+    bool check(const SolveSnapshot& snapshot);
+
+    // publishes the final snapshot
+    void finish(const SolveSnapshot& snapshot);
+
+    SolveStatus stopReason() const { return reason; }
+
+private:
+    void publish(const SolveSnapshot& snapshot);
+
+    long long every;
+
+    std::atomic<bool> cancelled;
+    std::atomic<long long> deadlineNs;      // steady_clock time in ns, LLONG_MAX if there is none
+
+    std::atomic<unsigned> sequence;         // odd while the worker writes the snapshot
+    std::atomic<long long> flow;
+    std::atomic<int> sourceLabel;
+    std::atomic<long long> iterations;
+    std::atomic<long long> augmentations;
+    std::atomic<bool> running;
+
+    SolveStatus reason;                     // only written and read by the worker
+};
+
+// what the future of solveAsync holds. the network is handed back with its flow in the residuals
+struct AsyncSolveResult
+{
+    SolveStatus status;
+    long long flow;
+    float cpuTime;              // cpu time of the worker thread in seconds
+    FlatNetwork network;
+};
+
+// handle of a solve started by solveAsync. it owns the worker thread and the control: if the
+// handle goes away before get(), the solve is cancelled and the worker joined, which takes at
+// most checkEvery iterations. an abandoned request frees the cpu at once and no worker outlives
+// its handle. handles can be moved but not copied
+class AsyncSolve
+{
+public:
+    AsyncSolve() {}
+    AsyncSolve(std::thread worker, std::future<AsyncSolveResult> result, std::shared_ptr<SolveControl> control);
+    AsyncSolve(AsyncSolve&& other) = default;
+    AsyncSolve& operator=(AsyncSolve&& other);
+    ~AsyncSolve();
+
+    AsyncSolve(const AsyncSolve&) = delete;
+    AsyncSolve& operator=(const AsyncSolve&) = delete;
+
+    // false for a default constructed handle and after get()
+    bool valid() const { return worker.joinable(); }
+
+    // cancel, setDeadline and progress of the running solve
+    SolveControl& control() { return *ctrl; }
+
+    // waits up to [timeout] and returns true if the result is ready
+    bool waitFor(std::chrono::milliseconds timeout);
+
+    // waits for the result and joins the worker
+    AsyncSolveResult get();
+
+private:
+    // cancels a solve that is still running and joins its worker
+    void release();
+
+    std::thread worker;
+    std::future<AsyncSolveResult> result;
+    std::shared_ptr<SolveControl> ctrl;
+};
+
+// how the last solve of the MaxFlowSolver version of solveAsync went
+struct AsyncSolveStats
+{
+    SolveStatus status;
+    long long flow;
+    int polls;                  // times the caller read the progress while it waited
+    float cpuTime;              // cpu time of the worker
+};
+
+/* Functions */
+
+// runs flatShortestAugmentedPath on N in a new thread and returns at once. N is moved into the
+// worker, so nothing the caller owns is touched while it runs. [control] can carry a deadline
+// set before the call
+AsyncSolve solveAsync(FlatNetwork N, int s, int t, std::shared_ptr<SolveControl> control);
+
+// builds the flat network of G with zero flow on the calling thread and solves it with the
+// FlatNetwork version. write the flow back with writeFlatFlow(G, result.network)
+AsyncSolve solveAsync(Graph& G, Vertex s, Vertex t, std::shared_ptr<SolveControl> control);
+
+// the deadline in milliseconds of the MaxFlowSolver version, from the start of the solve
+void setSolveDeadline(double milliseconds);
+
+// MaxFlowSolver version: solves G with solveAsync under the deadline of setSolveDeadline, reads
+// the progress while it waits and writes the flow back to G. past the deadline the flow is
+// feasible but not maximum. the solver time the benchmark measures is the cpu time of the
+// waiting thread, the worker's is in asyncSolveStats
+bool deadlineMaxFlow(Graph& G, Vertex s, Vertex t);
+
+// statistics of the last deadlineMaxFlow
+AsyncSolveStats asyncSolveStats();
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef BENCHMARKPIPELINE
+#define BENCHMARKPIPELINE
+
+#include <queue>
+#include <mutex>
+#include <condition_variable>
+#include <sched.h>
+
+// fixed size queue shared between the instance producers and the timed consumer.
+// push blocks while the queue is full and pop blocks while it is empty, so the
+// producers can never run more than [capacity] instances ahead of the solver.
+template <typename T>
+class BoundedQueue
+{
+public:
+    BoundedQueue(size_t capacity) : capacity(capacity) {}
+
+    void push(T item)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this]{ return items.size() < capacity; });
+        items.push(std::move(item));
+        notEmpty.notify_one();
+    }
+
+    T pop()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this]{ return !items.empty(); });
+        T item = std::move(items.front());
+        items.pop();
+        notFull.notify_one();
+        return item;
+    }
+
+private:
+    size_t capacity;
+    std::queue<T> items;
+    std::mutex mutex;
+    std::condition_variable notFull;
+    std::condition_variable notEmpty;
+};
+
+/* Functions */
+
+// number of online cores
+int numberOfCores();
+
+// pins the calling thread to [core]. returns false if the affinity could not be set
+bool pinThreadToCore(int core);
+
+// lets the calling thread run on every core except [core] so that the producers
+// stay off the core of the timed solver. returns false on single core machines
+bool pinThreadAwayFromCore(int core);
+
+// affinity of the calling thread, so that it can be given back with restoreThreadAffinity
+// after pinning it
+cpu_set_t threadAffinity();
+
+// sets the affinity of the calling thread to [set]. returns false if it could not be set
+bool restoreThreadAffinity(const cpu_set_t& set);
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef BIPARTITEMATCHING
+#define BIPARTITEMATCHING
+
+#include "boostGraphStruct.hpp"
+#include <vector>
+
+// assignment problems as max flow: s has an edge to every left vertex, every right vertex has
+// an edge to t, the other edges go from left to right and every capacity is 1. the max flow is
+// then a maximum matching, which Hopcroft-Karp finds in O(m sqrt(n)) without a residual network
+struct BipartiteNetwork
+{
+    int left;
+    int right;
+
+    std::vector<int> first;         // left + 1 offsets into adj
+    std::vector<int> adj;           // right vertex of every left to right edge
+    std::vector<Edge> arcEdge;      // edge of G of every entry of adj
+
+    std::vector<Edge> sourceEdge;   // s -> left vertex u
+    std::vector<Edge> sinkEdge;     // right vertex v -> t
+};
+
+/* Functions */
+
+// returns true if G with source s and sink t has the structure above and builds B. a left
+// vertex must have exactly one edge from s and a right vertex exactly one edge to t, otherwise
+// a vertex could carry more than one unit and the max flow would not be a matching
+bool buildBipartiteNetwork(Graph& G, Vertex s, Vertex t, BipartiteNetwork& B);
+
+// maximum matching of B. matchArc[u] is the index into adj of the edge matched to left vertex
+// u, or -1. returns the size of the matching
+int hopcroftKarp(const BipartiteNetwork& B, std::vector<int>& matchArc);
+
+// max flow of the network B was built from, the matching of hopcroftKarp written to G[e].f.
+// returns false if t is not reachable from s
+bool bipartiteMaxFlow(Graph& G, const BipartiteNetwork& B);
+
+// MaxFlowSolver that solves unit capacity bipartite instances with hopcroftKarp and writes the
+// matching to G[e].f. every other instance goes to flatShortestAugmentedPath.
+// returns false if t is not reachable from s
+bool bipartiteMaxFlow(Graph& G, Vertex s, Vertex t);
+
+#endif
@@ -0,0 +1,20 @@
+#ifndef BOOSTBASELINES
+#define BOOSTBASELINES
+
+#include "boostGraphStruct.hpp"
+
+// Boost's own max flow algorithms as MaxFlowSolvers, so that there is a reference to compare
+// against without LEDA. they need a reverse edge for every edge and residual and reverse
+// property maps, which Graph does not have, so each one copies G into a graph that has them,
+// solves it and writes the flow back to G[e].f. they return true once the algorithm finished,
+// also when the max flow is 0
+
+/* Functions */
+
+bool boostEdmondsKarp(Graph& G, Vertex s, Vertex t);
+
+bool boostPushRelabel(Graph& G, Vertex s, Vertex t);
+
+bool boostBoykovKolmogorov(Graph& G, Vertex s, Vertex t);
+
+#endif
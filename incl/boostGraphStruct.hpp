@@ -47,6 +47,10 @@ typedef boost::graph_traits<Graph>::out_edge_iterator OutEdgeIterator;
 typedef boost::graph_traits<Graph>::in_edge_iterator InEdgeIterator;
 typedef boost::graph_traits<Graph>::adjacency_iterator AdjIterator;
 
+/* Solvers */
+// a max flow solver leaves the flow from s to t in G[e].f and returns false if t is not reachable from s
+typedef bool (*MaxFlowSolver)(Graph& G, Vertex s, Vertex t);
+
 /* Functions */                    /* μπορούμε να χρησιμοποιήσουμε και array αντί για vector για το dist και το pred */
 // in specific files
 
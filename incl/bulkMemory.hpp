@@ -0,0 +1,85 @@
+#ifndef BULKMEMORY
+#define BULKMEMORY
+
+#include <vector>
+#include <cstddef>
+#include <new>
+
+// where the pages of a bulk array are placed on a machine with several NUMA nodes
+enum BulkPlacement
+{
+    PLACEMENT_DEFAULT,          // wherever the kernel puts them, usually the node of the thread that writes them first
+    PLACEMENT_INTERLEAVE,       // round robin over all nodes with mbind(MPOL_INTERLEAVE)
+    PLACEMENT_FIRST_TOUCH       // split into one chunk per core, each written first by a thread pinned to that core
+};
+
+enum BulkHugePages
+{
+    HUGE_PAGES_NONE,
+    HUGE_PAGES_MADVISE,         // transparent huge pages through madvise(MADV_HUGEPAGE)
+    HUGE_PAGES_EXPLICIT         // MAP_HUGETLB from the reserved huge page pool, madvise if the pool is empty
+};
+
+// how the solver arrays that grow with the graph (arcs, residuals, labels) are allocated.
+// arrays smaller than minBytes, and all arrays under the default policy, come from the heap
+struct BulkMemoryPolicy
+{
+    BulkPlacement placement;
+    BulkHugePages hugePages;
+    int touchThreads;           // threads of PLACEMENT_FIRST_TOUCH, 0 for one per core
+    size_t minBytes;
+
+    BulkMemoryPolicy() : placement(PLACEMENT_DEFAULT), hugePages(HUGE_PAGES_NONE), touchThreads(0), minBytes(1 << 20) {}
+};
+
+// what the policy did so far. every request that could not be honoured, like MAP_HUGETLB
+// without reserved pages or mbind without NUMA support in the kernel, counts as a fallback
+struct BulkMemoryStats
+{
+    long long mappedBytes;
+    long long explicitHugeBytes;
+    long long interleavedBytes;
+    long long firstTouchBytes;
+    long long fallbacks;
+};
+
+/* Functions */
+
+// sets the policy for later allocations. call it before other threads start
+void setBulkMemoryPolicy(const BulkMemoryPolicy& policy);
+const BulkMemoryPolicy& bulkMemoryPolicy();
+
+BulkMemoryStats bulkMemoryStats();
+
+// number of NUMA nodes, 1 if it cannot be read from /sys
+int numaNodes();
+
+// memory for [bytes] bytes under the current policy, aligned to 64 bytes. throws std::bad_alloc
+void* bulkAllocate(size_t bytes);
+
+// frees memory of bulkAllocate, whatever the policy is now
+void bulkFree(void* p);
+
+// allocator of the bulk arrays
+template <typename T>
+struct BulkAllocator
+{
+    typedef T value_type;
+
+    BulkAllocator() {}
+    template <typename U> BulkAllocator(const BulkAllocator<U>&) {}
+
+    T* allocate(size_t n) { return static_cast<T*>(bulkAllocate(n * sizeof(T))); }
+    void deallocate(T* p, size_t) { bulkFree(p); }
+};
+
+template <typename T, typename U>
+bool operator==(const BulkAllocator<T>&, const BulkAllocator<U>&) { return true; }
+
+template <typename T, typename U>
+bool operator!=(const BulkAllocator<T>&, const BulkAllocator<U>&) { return false; }
+
+template <typename T>
+using BulkVector = std::vector<T, BulkAllocator<T> >;
+
+#endif
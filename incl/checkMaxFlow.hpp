@@ -6,4 +6,9 @@
 /* Functions */                    /* μπορούμε να χρησιμοποιήσουμε και array αντί για vector για το dist και το pred */
 bool CHECK_MAX_FLOW_T(Graph& G, Vertex s, Vertex t, bool printErrorName = true);
 
+class SolverWorkspace;
+
+// same, with the scratch buffers of [ws] instead of the workspace of the calling thread
+bool CHECK_MAX_FLOW_T(Graph& G, Vertex s, Vertex t, bool printErrorName, SolverWorkspace& ws);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,88 @@
+#ifndef DYNAMICMAXFLOW
+#define DYNAMICMAXFLOW
+
+#include "boostGraphStruct.hpp"
+#include "flatNetwork.hpp"
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+// what the last solve of a DynamicMaxFlow did
+struct DynamicMaxFlowStats
+{
+    long long cancelledFlow;    // flow removed to make the flow feasible again
+    int cancelPaths;            // paths it was removed along
+    bool rebuilt;               // edges were inserted or deleted, so the flat network was rebuilt
+};
+
+// max flow of a graph that changes a few edges at a time. the flow of the last solve is kept in
+// a FlatNetwork and every solve starts from it instead of from zero. changes are batched and
+// applied by solve: lowered capacities and deleted edges can leave a vertex with more flow in than
+// out or the other way round, and that imbalance is cancelled along paths of flow carrying edges
+// back to s or on to t (or to a vertex with the opposite imbalance), which only touches the flow
+// around the change. the repaired flow is then augmented with flatShortestAugmentedPath.
+//
+// G is the graph of the caller. it has to be changed through this class between solves, so
+// that its edges and the flat network stay in sync, and solve writes the flow to G[e].f.
+class DynamicMaxFlow
+{
+public:
+    // starts from the flow in G[e].f. it does not have to be feasible, solve repairs it
+    DynamicMaxFlow(Graph& G, Vertex s, Vertex t);
+
+    // changes to an edge that was deleted since the last solve, and deleting it again, are ignored
+    void setCapacity(Edge e, int cap);
+    Edge insertEdge(Vertex u, Vertex w, int cap);
+    void deleteEdge(Edge e);
+
+    // applies the pending changes, repairs the flow and augments it to a max flow.
+    // returns false if t is not reachable from s
+    bool solve();
+
+    long long flowValue() const;
+
+    DynamicMaxFlowStats stats;
+
+private:
+    // builds N, the arc capacities and the edge numbers from G
+    void rebuild();
+
+    // lowers the flow on arcs whose residual is negative and records the imbalance it leaves
+    void clampArc(int a);
+
+    // returns true if t is reachable from s over edges with capacity
+    bool reachable() const;
+
+    // cancels the imbalance of every vertex except s and t
+    void repair();
+
+    // cancels up to the excess of v along a path of flow carrying arcs into v. returns false if there is none
+    bool cancelExcess(int v);
+
+    // cancels up to the deficit of v along a path of flow carrying arcs out of v
+    bool cancelDeficit(int v);
+
+    // sets searchPred back to -1 for the vertices the last search reached and [found], if not -1
+    void clearSearch(int found);
+
+    Graph& G;
+    int s;
+    int t;
+
+    FlatNetwork N;
+    std::vector<int> arcCap;                            // edge capacity for forward arcs, 0 for reverse arcs
+    std::vector<long long> excess;                      // flow in minus flow out of every vertex
+    std::unordered_map<const myEdge*, int> edgeNumber;  // edge of G to its number in N
+
+    // bfs buffers of cancelExcess and cancelDeficit. pred is -1 for every vertex between two
+    // searches, so a search only resets the vertices it reached instead of allocating n entries
+    std::vector<int> searchPred;
+    std::vector<int> searchQueue;
+
+    std::vector<std::pair<int, int> > capacityChanges;  // (edge number, capacity)
+    std::vector<Edge> deleted;
+    std::unordered_set<const myEdge*> deletedEdges;     // the edges of deleted, to ignore repeats
+    bool inserted;
+};
+
+#endif
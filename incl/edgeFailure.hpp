@@ -0,0 +1,86 @@
+#ifndef EDGEFAILURE
+#define EDGEFAILURE
+
+#include "boostGraphStruct.hpp"
+#include "flatNetwork.hpp"
+#include "solverWorkspace.hpp"
+#include <vector>
+#include <utility>
+
+// how the flow without an edge was found
+enum FailureOutcome
+{
+    FAILURE_NO_FLOW,    // the edge carries no flow, so the base flow is still maximum
+    FAILURE_ON_CUT,     // the edge crosses the min cut of the base flow: the flow drops by its capacity
+    FAILURE_RESOLVED    // the flow of the edge was taken out and the rest re-augmented
+};
+
+struct EdgeFailure
+{
+    Edge e;
+    long long flow;             // max flow of G without e
+    FailureOutcome outcome;
+};
+
+struct FailureAnalysisStats
+{
+    long long baseFlow;
+    int noFlow;                 // edges of each outcome
+    int onCut;
+    int resolved;
+    int threads;
+    long long touchedArcs;      // arcs changed by all forks together, the work of the copy on write
+    double seconds;             // wall clock time of the whole analysis, base solve included
+};
+
+// residuals of a base flow that can be changed and put back. every worker copies the residuals
+// once; a fork then records the old value of an arc the first time it writes it and discard()
+// writes those values back, so the next fork starts from the base flow again at the cost of the
+// arcs the last one touched instead of a copy of all 2m
+class FlowFork
+{
+public:
+    explicit FlowFork(const FlatNetwork& base);
+
+    int residual(int a) const { return r[a]; }
+
+    // moves [delta] of residual from arc a to its mate, which sends [delta] along a
+    void push(int a, int delta);
+
+    // sets the residual of arc a without touching its mate
+    void set(int a, int value);
+
+    // back to the base residuals
+    void discard();
+
+    // arcs changed since the last discard
+    int touched() const { return saved.size(); }
+
+    const FlatNetwork& network() const { return N; }
+
+private:
+    void save(int a);
+
+    const FlatNetwork& N;
+    BulkVector<int> r;
+    std::vector<unsigned int> stamp;            // arcs saved in this fork have the current epoch
+    unsigned int epoch;
+    std::vector<std::pair<int, int> > saved;    // (arc, base residual)
+};
+
+/* Functions */
+
+// max flow of G without each edge of [candidates] in turn, for resilience planning. G is solved
+// once with flatShortestAugmentedPath and the base flow is written to G. an edge without flow
+// leaves the flow value unchanged, and an edge that crosses the min cut of the base flow lowers
+// it by exactly its capacity, so neither is solved again. for every other edge a fork of the base
+// flow gives the edge's flow f back: first along other paths from its tail to its head, then what
+// is left back to s from the tail and from t to the head, and the fork is augmented from s to t
+// again, which takes at most f more units. forks are run on [threads] threads (0: one per core),
+// each with its own copy of the residuals. returns false if t is not reachable from s
+bool edgeFailureSensitivity(Graph& G, Vertex s, Vertex t, const std::vector<Edge>& candidates, int threads, std::vector<EdgeFailure>& results, FailureAnalysisStats& stats);
+
+// max flow of the fork without edge k of its network, which has flow [baseFlow]
+long long forkedFailureFlow(FlowFork& F, int s, int t, int k, long long baseFlow, SolverWorkspace& ws);
+
+#endif
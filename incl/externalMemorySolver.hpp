@@ -0,0 +1,126 @@
+#ifndef EXTERNALMEMORYSOLVER
+#define EXTERNALMEMORYSOLVER
+
+#include "boostGraphStruct.hpp"
+#include <vector>
+#include <string>
+#include <functional>
+
+// one arc of the file backed residual network. cap is the capacity of the edge the arc belongs
+// to, so the residual of the reverse arc is always cap - residual and never has to be read
+struct ExternalArc
+{
+    int head;
+    int residual;
+    int cap;
+    int unused;
+    long long mate;
+};
+
+// settings of the out-of-core mode
+struct ExternalMemoryOptions
+{
+    std::string directory;      // where the arc file is created
+    size_t cacheBytes;          // memory for resident arc blocks
+    int blockArcs;              // arcs per block
+    int readAhead;              // blocks after a missed block that the kernel is asked to prefetch
+    size_t maxPendingUpdates;   // batched residual updates kept in memory before they are written
+
+    ExternalMemoryOptions() : directory("/tmp"), cacheBytes(64 << 20), blockArcs(4096), readAhead(4), maxPendingUpdates(1 << 20) {}
+};
+
+// arc array kept in a file and paged in block by block through a small clock cache.
+// residual updates to blocks that are not resident are queued per block and applied
+// when the block is loaded again or when too many of them are pending
+class ExternalArcStore
+{
+public:
+    ExternalArcStore();
+    ~ExternalArcStore();
+
+    // owns a file descriptor
+    ExternalArcStore(const ExternalArcStore&) = delete;
+    ExternalArcStore& operator=(const ExternalArcStore&) = delete;
+
+    // creates an unlinked arc file for [arcs] arcs. returns false if the file could not be created
+    bool open(long long arcs, const ExternalMemoryOptions& options);
+    void close();
+
+    ExternalArc read(long long a);
+    void write(long long a, const ExternalArc& arc);
+
+    // adds [delta] to the residual of arc a without loading its block if it is not resident
+    void addResidual(long long a, int delta);
+
+    // applies every pending update and writes the dirty blocks back to the file
+    void flush();
+
+    long long blockReads;
+    long long blockWrites;
+    long long batchedUpdates;
+
+private:
+    struct Frame
+    {
+        long long block;
+        bool dirty;
+        bool referenced;
+        std::vector<ExternalArc> arcs;
+    };
+
+    // returns the frame holding [block], loading it if needed
+    Frame& load(long long block);
+    void evict(Frame& frame);
+    void flushPending();
+
+    int fd;
+    long long arcs;
+    long long blocks;
+    int blockArcs;
+    int readAhead;
+    size_t maxPendingUpdates;
+
+    std::vector<Frame> frames;
+    std::vector<int> frameOfBlock;      // -1 if the block is not resident
+    size_t clockHand;
+
+    std::vector<std::vector<std::pair<int, int> > > pending;    // (arc in block, delta) per block
+    size_t pendingUpdates;
+};
+
+// residual network for the semi-external solver. the vertex arrays are in memory, the arcs
+// are in the store. the arcs of v are first[v] .. first[v+1]-1, out edges before in edges
+struct ExternalNetwork
+{
+    int n;
+    long long m;
+    std::vector<long long> first;
+    std::vector<int> outDegree;
+    ExternalArcStore store;
+};
+
+// calls its argument once for every edge (u, w, cap). it is called twice while the network is
+// built and once more when the flow is read back, and has to list the edges in the same order
+typedef std::function<void(const std::function<void(int u, int w, int cap)>&)> EdgeStream;
+
+/* Functions */
+
+// the options used by the MaxFlowSolver version of externalShortestAugmentedPath
+void setExternalMemoryOptions(const ExternalMemoryOptions& options);
+
+// builds the network of the [n] vertex graph listed by [edges] with zero flow. only the vertex
+// arrays are kept in memory. returns false if the arc file could not be created
+bool buildExternalNetwork(int n, const EdgeStream& edges, const ExternalMemoryOptions& options, ExternalNetwork& N);
+
+// the shortest augmenting path algorithm of flatShortestAugmentedPath with the arcs out of core.
+// d, pred, the current arcs and the residual of the arc each vertex was reached with stay in memory,
+// so augmenting never reads an arc back. returns false if t is not reachable from s
+bool externalShortestAugmentedPath(ExternalNetwork& N, int s, int t);
+
+// calls [flow] with the index and flow of every edge of [edges] in order
+void forEachExternalEdgeFlow(ExternalNetwork& N, const EdgeStream& edges, const std::function<void(long long k, int flow)>& flow);
+
+// MaxFlowSolver version: builds the network of G in a file, solves it and writes the flow back to G
+bool externalShortestAugmentedPath(Graph& G, Vertex s, Vertex t);
+
+#endif
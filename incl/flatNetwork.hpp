@@ -0,0 +1,57 @@
+#ifndef FLATNETWORK
+#define FLATNETWORK
+
+#include "boostGraphStruct.hpp"
+#include "bulkMemory.hpp"
+#include <vector>
+
+// residual network of a Graph stored in contiguous arrays instead of Boost's per-edge list nodes.
+// every edge of G becomes a forward arc with residual cap - f at its source and a reverse arc
+// with residual f at its target, so the reverse edges that shortestAugmentedPath simulates are
+// real arcs here. the arcs of vertex v are first[v] .. first[v+1]-1, out edges before in edges.
+// the arrays are allocated under the BulkMemoryPolicy of bulkMemory.hpp
+struct FlatNetwork
+{
+    int n;
+    int m;                          // edges of G. the network has 2m arcs
+
+    BulkVector<int> first;          // n + 1 offsets into the arc arrays
+    BulkVector<int> head;           // target of every arc
+    BulkVector<int> residual;       // residual capacity of every arc
+    BulkVector<int> mate;           // the reverse arc of every arc
+
+    std::vector<Edge> edges;        // edges of G. edges[k] is edge k
+    BulkVector<int> forwardArc;     // forward arc of edge k. its mate is the reverse arc
+};
+
+/* Functions */
+
+// builds the residual network of G for the flow currently stored in G[e].f
+void buildFlatNetwork(Graph& G, FlatNetwork& N);
+
+// same, with vertex v of G as vertex index[v] of N so that vertices that are solved together can
+// be stored together. edges keep their numbers, so writeFlatFlow does not need the index
+void buildFlatNetwork(Graph& G, const std::vector<int>& index, FlatNetwork& N);
+
+// writes the flow of N back to G[e].f. the flow of an edge is the residual of its reverse arc
+void writeFlatFlow(Graph& G, const FlatNetwork& N);
+
+// net flow out of s, the flow value if s is the source
+long long flatFlowValue(const FlatNetwork& N, int s);
+
+// flow of edge k
+inline int flatEdgeFlow(const FlatNetwork& N, int k){
+    return N.residual[N.mate[N.forwardArc[k]]];
+}
+
+// capacity of edge k
+inline int flatEdgeCap(const FlatNetwork& N, int k){
+    return N.residual[N.forwardArc[k]] + N.residual[N.mate[N.forwardArc[k]]];
+}
+
+// tail of arc a
+inline int flatArcTail(const FlatNetwork& N, int a){
+    return N.head[N.mate[a]];
+}
+
+#endif
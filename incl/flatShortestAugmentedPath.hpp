@@ -0,0 +1,59 @@
+#ifndef FLATSHORTESTAUGMENTEDPATH
+#define FLATSHORTESTAUGMENTEDPATH
+
+#include "boostGraphStruct.hpp"
+#include "flatNetwork.hpp"
+#include <vector>
+#include <functional>
+
+// state of a running flat solve, passed to a FlatSolverMonitor
+struct FlatSolveProgress
+{
+    long long flow;             // current flow value from s to t
+    long long iterations;       // advance and retreat steps so far
+    long long augmentations;
+    int sourceLabel;            // d[s]
+    const BulkVector<int>* d;   // current distance labels
+};
+
+// called every [every] iterations of the main loop. returning false stops the solver early,
+// leaving a feasible but not necessarily maximum flow in the network
+struct FlatSolverMonitor
+{
+    long long every;
+    std::function<bool(const FlatSolveProgress&)> check;
+};
+
+class SolverWorkspace;
+
+/* Functions */
+
+// the shortest augmenting path algorithm of shortestAugmentedPath on a FlatNetwork. reverse
+// edges are real arcs, so advance only looks at one arc list. it also keeps a current arc per
+// vertex and stops as soon as a distance label is left with no vertex (Ahuja and Orlin's gap
+// test) instead of waiting for d[s] >= n. the admissible arc search and the min label of
+// retreat go through the kernels of arcScan.hpp.
+
+// builds the flat network of G, solves it from zero flow and writes the flow back to G.
+// returns false if t is not reachable from s
+bool flatShortestAugmentedPath(Graph& G, Vertex s, Vertex t);
+
+// same, building the network and the solver arrays in the buffers of [ws]. the versions without
+// a workspace use the one of the calling thread
+bool flatShortestAugmentedPath(Graph& G, Vertex s, Vertex t, SolverWorkspace& ws);
+
+// solves N starting from the flow its residuals describe. returns false if t is not reachable from s
+bool flatShortestAugmentedPath(FlatNetwork& N, int s, int t);
+
+// same, with an optional [monitor] (may be NULL) that can watch the progress and stop the solver
+bool flatShortestAugmentedPath(FlatNetwork& N, int s, int t, const FlatSolverMonitor* monitor);
+bool flatShortestAugmentedPath(FlatNetwork& N, int s, int t, const FlatSolverMonitor* monitor, SolverWorkspace& ws);
+
+// exact distance labels to t in the residual network, computed with a reverse bfs.
+// vertices that cannot reach t get the label n
+void flatExactLabels(const FlatNetwork& N, int t, BulkVector<int>& d);
+
+// same, with the bfs queue in [queue]
+void flatExactLabels(const FlatNetwork& N, int t, BulkVector<int>& d, BulkVector<int>& queue);
+
+#endif
@@ -0,0 +1,99 @@
+#ifndef FLOWCACHE
+#define FLOWCACHE
+
+#include "boostGraphStruct.hpp"
+#include <cstdint>
+#include <vector>
+#include <list>
+#include <unordered_map>
+
+// results of max flow queries kept for graphs that are asked about again between changes. the
+// key is a 64 bit fingerprint of the graph and the terminal pair. the fingerprint is a sum of one
+// hash per edge, so a change only adds and subtracts the hashes of the edges it touches and a
+// lookup never hashes the whole graph again
+
+// fingerprint of a graph that is changed through it. the hash of an edge depends on its ends and
+// its capacity, not on its place in the edge lists, so the same graph built in another order or
+// changed and changed back has the same fingerprint
+class GraphFingerprint
+{
+public:
+    // hashes every edge of G once
+    GraphFingerprint(Graph& G);
+
+    void setCapacity(Edge e, int cap);
+    Edge insertEdge(Vertex u, Vertex w, int cap);
+    void deleteEdge(Edge e);
+
+    uint64_t value() const { return hash; }
+
+    // changes with every insertion and deletion. flows stored in edge order are only valid
+    // for the layout they were stored under, because edge lists are reordered by the changes
+    uint64_t layout() const { return layoutId; }
+
+private:
+    Graph& G;
+    uint64_t hash;
+    uint64_t layoutId;
+};
+
+struct FlowCacheEntry
+{
+    uint64_t fingerprint;
+    int s;
+    int t;
+    long long flow;
+    std::vector<uint64_t> sourceSide;   // bit v is set if v is on the s side of the min cut
+    std::vector<int> flows;             // flow of every edge in edges(G) order, empty if not kept
+    uint64_t layout;                    // layout of the graph the flows were stored under
+
+    // memory charged to the budget
+    size_t bytes() const;
+
+    bool onSourceSide(int v) const { return (sourceSide[v >> 6] >> (v & 63)) & 1; }
+};
+
+// least recently used entries are dropped once the entries take more than the memory budget
+class FlowCache
+{
+public:
+    // [storeFlows] : also keep the flow of every edge, so that a hit can write it back to G
+    FlowCache(size_t budgetBytes, bool storeFlows);
+
+    // the entry of G with fingerprint [fingerprint] and terminals s, t or NULL. a hit makes the
+    // entry the most recently used one
+    const FlowCacheEntry* lookup(uint64_t fingerprint, Vertex s, Vertex t);
+
+    // stores the max flow in G[e].f under [fingerprint], with the min cut it leaves. returns
+    // the flow value
+    long long store(Graph& G, Vertex s, Vertex t, const GraphFingerprint& fingerprint);
+
+    void clear();
+
+    size_t bytes() const { return used; }
+    size_t entries() const { return lru.size(); }
+
+    long long hits;
+    long long misses;
+    long long evictions;
+
+private:
+    // drops the least recently used entries until [extra] more bytes fit in the budget
+    void evict(size_t extra);
+
+    size_t budget;
+    bool storeFlows;
+    size_t used;
+
+    std::list<FlowCacheEntry> lru;      // most recently used first
+    std::unordered_map<uint64_t, std::list<FlowCacheEntry>::iterator> index;
+};
+
+/* Functions */
+
+// answers a query from [cache] or runs [solver] and stores the result. with [needFlows] a hit
+// that has no flows for the current layout of G counts as a miss, otherwise G[e].f is only
+// written when the entry has them. returns the flow value, 0 if t is not reachable from s
+long long cachedMaxFlow(Graph& G, Vertex s, Vertex t, const GraphFingerprint& fingerprint, FlowCache& cache, MaxFlowSolver solver, bool needFlows);
+
+#endif
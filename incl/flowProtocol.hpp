@@ -0,0 +1,74 @@
+#ifndef FLOWPROTOCOL
+#define FLOWPROTOCOL
+
+#include <stdint.h>
+#include <string>
+
+// messages between the flow server and its clients over a Unix domain stream socket. a client
+// sends fixed size requests and may send many before reading any answer. the server answers every
+// request with a fixed size response. only a min cut response is followed by more, [count] pairs of
+// int32 (tail, head) that are the edges of the cut. responses can arrive in another order than the
+// requests, the client matches them by [id]. both sides run on the same machine, so the fields are
+// in its byte order
+
+const char DEFAULT_FLOW_SOCKET[] = "/tmp/adst-flow.sock";
+
+enum FlowOp
+{
+    FLOW_OP_INFO = 1,       // flow = vertices, count = edges, s and t of the graph file
+    FLOW_OP_MAX_FLOW = 2,   // flow = max flow value from s to t
+    FLOW_OP_MIN_CUT = 3,    // flow = cut capacity, followed by the count edges of the cut
+    FLOW_OP_CHECK = 4,      // FLOW_OK if [value] is the max flow value from s to t, flow = max flow value
+    FLOW_OP_SHUTDOWN = 5    // the server stops accepting and exits after the queued requests
+};
+
+enum FlowStatus
+{
+    FLOW_OK = 0,
+    FLOW_BAD_OP = 1,
+    FLOW_BAD_GRAPH = 2,     // no loaded graph has that number
+    FLOW_BAD_VERTEX = 3,    // s or t is not a vertex of the graph, or s == t
+    FLOW_CHECK_FAILED = 4   // the value of a check query is not the max flow value
+};
+
+struct FlowRequest
+{
+    uint32_t id;            // chosen by the client, copied to the response
+    uint8_t op;             // FlowOp
+    uint8_t unused[3];
+    int32_t graph;          // number of the graph in the order the server loaded them
+    int32_t s;              // -1: the s and t of the graph file
+    int32_t t;
+    int32_t unused2;
+    int64_t value;          // the flow value a check query claims
+};
+
+struct FlowResponse
+{
+    uint32_t id;
+    uint8_t op;
+    uint8_t status;         // FlowStatus
+    uint8_t unused[2];
+    int64_t flow;
+    uint32_t count;         // min cut: edges that follow the response. info: edges of the graph
+    uint32_t solveMicros;   // time the worker spent on the query, without the time it was queued
+};
+
+static_assert(sizeof(FlowRequest) == 32, "FlowRequest is sent as it is");
+static_assert(sizeof(FlowResponse) == 24, "FlowResponse is sent as it is");
+
+/* Functions */
+
+// reads or writes exactly [bytes] bytes, retrying on short transfers and signals. returns false
+// if the socket was closed or failed
+bool readFully(int fd, void* data, size_t bytes);
+bool writeFully(int fd, const void* data, size_t bytes);
+
+// connects to the server at [path]. returns the socket, or -1 after printing the reason
+int connectFlowServer(const std::string& path);
+
+// short name of a FlowOp or FlowStatus
+const char* flowOpName(int op);
+const char* flowStatusName(int status);
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef GRAPHFORMATS
+#define GRAPHFORMATS
+
+#include "boostGraphStruct.hpp"
+#include <string>
+
+// graphs on disk, so that a graph can be loaded instead of generated. DIMACS is the text format of
+// the max flow challenge: "c" comment lines, one "p max n m" line, "n v s" and "n v t" for the
+// source and the sink and one "a u w cap" line per edge, with vertices numbered from 1. the binary
+// format holds the same graph as the magic "ADSTFLW1", the int32 fields n, m, s, t and then m
+// records of int32 tail, head, cap with vertices numbered from 0, all in the byte order of the
+// machine that wrote it. it is read in one pass without parsing and is what the flow server loads
+// the large graphs from
+
+/* Functions */
+
+// replaces G with the graph in [path]. returns false and prints the reason if the file cannot be
+// read or is malformed
+bool readDimacsGraph(const std::string& path, Graph& G, Vertex& s, Vertex& t);
+bool readBinaryGraph(const std::string& path, Graph& G, Vertex& s, Vertex& t);
+
+// writes G without its flow. returns false if the file cannot be written
+bool writeDimacsGraph(const std::string& path, Graph& G, Vertex s, Vertex t);
+bool writeBinaryGraph(const std::string& path, Graph& G, Vertex s, Vertex t);
+
+// true if [path] ends in .bin, the files readGraphFile reads with readBinaryGraph
+bool isBinaryGraphPath(const std::string& path);
+
+// reads [path] as binary or DIMACS by its extension
+bool readGraphFile(const std::string& path, Graph& G, Vertex& s, Vertex& t);
+
+#endif
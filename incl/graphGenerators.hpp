@@ -0,0 +1,53 @@
+#ifndef GRAPHGENERATORS
+#define GRAPHGENERATORS
+
+#include "boostGraphStruct.hpp"
+
+// instances built straight into a Boost graph from a fixed seed, so that programs that do not
+// link LEDA can run the solvers on the same kind of graphs as main. vertices are named by
+// their index and capacities are uniform in [100, 10000] like randomCapacities in main
+
+/* Functions */
+
+// random simple loop free graph with [n] vertices and [m] edges. s and t are random vertices
+// with t reachable from s
+void generateRandomGraph(Graph& G, int n, int m, unsigned seed, Vertex& s, Vertex& t);
+
+// [n] x [n] grid with edges to the right and down, laid out like generateGridInstance in main.
+// s is the top left and t the bottom right vertex
+void generateGridGraph(Graph& G, int n, unsigned seed, Vertex& s, Vertex& t);
+
+// assignment instance with [n] left and [n] right vertices and [m] random left to right edges.
+// s has an edge to every left vertex, every right vertex has an edge to t and every capacity is 1
+void generateBipartiteGraph(Graph& G, int n, int m, unsigned seed, Vertex& s, Vertex& t);
+
+// hard instance families for stress benchmarks. uniform random graphs and the grid are easy for
+// augmenting path solvers: short paths, few relabels. these are built to make them work
+
+// network after Cherkassky and Goldberg's AK generator, 4k + 2 vertices and 5k + 1 edges. the
+// first module sends k units from s over paths of length 3, 5, .., 2k + 1 that share their edges,
+// so every augmentation is one longer than the last and the distance labels along the module are
+// raised one at a time, O(k^2) work in all. the second module is a path of length k with a dead
+// end at every vertex, which push-relabel floods and then has to drain back. deterministic, the
+// capacities follow from k
+void generateAKGraph(Graph& G, int k, Vertex& s, Vertex& t);
+
+// GENRMF of Goldfarb and Grigoriadis: [b] frames of [a] x [a] grids. the vertices of a frame are
+// joined to their grid neighbours in both directions with capacity c2 * a * a, and every vertex
+// has one edge to a random vertex of the next frame (a random permutation per frame pair) with a
+// capacity uniform in [c1, c2]. s is the first vertex of the first frame and t the last vertex of
+// the last one, so paths are long and cross every frame
+void generateGenrmfGraph(Graph& G, int a, int b, int c1, int c2, unsigned seed, Vertex& s, Vertex& t);
+
+// random level graph of the Washington generator: [rows] x [levels] vertices, every vertex of a
+// level has edges to 3 random vertices of the next level, s has an edge to every vertex of the
+// first level and every vertex of the last level has an edge to t
+void generateWashingtonGraph(Graph& G, int rows, int levels, unsigned seed, Vertex& s, Vertex& t);
+
+// R-MAT power law graph with 2^[scale] vertices and up to [edgeFactor] * 2^scale edges, each
+// placed by descending into the quadrant probabilities 0.57, 0.19, 0.19, 0.05. loops and
+// repeated edges are dropped. s is the vertex of highest out degree and t a random vertex
+// reachable from it, so the degrees on both sides of the cut are skewed
+void generateRmatGraph(Graph& G, int scale, int edgeFactor, unsigned seed, Vertex& s, Vertex& t);
+
+#endif
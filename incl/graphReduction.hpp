@@ -0,0 +1,47 @@
+#ifndef GRAPHREDUCTION
+#define GRAPHREDUCTION
+
+#include "boostGraphStruct.hpp"
+#include <vector>
+
+// every arc of a reduced graph stands for a series-parallel tree of original edges.
+// a leaf is one edge of the original graph, a series node is a contracted chain of
+// degree 2 vertices and a parallel node is a group of merged arcs between the same vertices
+struct ReductionNode
+{
+    enum Kind { LEAF, SERIES, PARALLEL };
+
+    Kind kind;
+    int cap;
+    Edge edge;                  // only used by leaves
+    std::vector<int> children;  // only used by series and parallel nodes
+};
+
+// reduced copy of a graph and everything needed to expand a flow on it back to the original
+struct ReducedGraph
+{
+    Graph G;
+    Vertex s;
+    Vertex t;
+
+    // reduced vertex -> vertex of the original graph
+    std::vector<Vertex> originalVertex;
+
+    // arcs[k] is an edge of G and arcRoot[k] is the root of its tree in nodes
+    std::vector<Edge> arcs;
+    std::vector<int> arcRoot;
+    std::vector<ReductionNode> nodes;
+};
+
+/* Functions */
+
+// builds the reduced graph of G in R. vertices that are not on any s-t path are dropped,
+// chains of vertices with one in and one out arc are contracted into a single arc with the
+// min capacity and parallel arcs are merged into one arc with the sum of their capacities.
+// the max flow of R.G from R.s to R.t is the max flow of G from s to t
+void reduceGraph(Graph& G, Vertex s, Vertex t, ReducedGraph& R);
+
+// writes the flow found on R.G back to the edges of G. dropped edges get zero flow
+void expandReducedFlow(Graph& G, const ReducedGraph& R);
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef MEMORYACCOUNTING
+#define MEMORYACCOUNTING
+
+// counts the allocations made through operator new. the replacement operators in
+// memoryAccounting.cpp only count while counting is enabled, and then only touch
+// counters of the calling thread, so the producer threads of the benchmark do not
+// show up in the numbers of the timed thread and no counter is shared between threads
+
+// counters of the calling thread
+struct AllocationCounters
+{
+    long long allocations;
+    long long frees;
+    long long bytes;            // allocated in total
+    long long liveBytes;        // allocated minus freed. memory freed here but allocated by another thread makes it smaller
+    long long peakLiveBytes;
+};
+
+// what a phase allocated
+struct PhaseMemory
+{
+    long long allocations;
+    long long bytes;            // allocated in total
+    long long peakBytes;        // most memory the phase held at once
+};
+
+/* Functions */
+
+// turns counting on or off for all threads. off by default. call it before other threads start
+void setAllocationCounting(bool enabled);
+bool allocationCounting();
+
+AllocationCounters threadAllocations();
+
+// starts a phase on the calling thread. phases on the same thread must not overlap
+void memoryPhaseStart(AllocationCounters& start);
+
+// the allocations of the calling thread since memoryPhaseStart
+PhaseMemory memoryPhaseEnd(const AllocationCounters& start);
+
+// peak resident set size of the process in kB, from getrusage
+long peakRSSKilobytes();
+
+// current resident set size of the process in kB, from /proc/self/statm. -1 if it cannot be read
+long currentRSSKilobytes();
+
+// resets the peak that /proc/self/status reports as VmHWM. getrusage keeps its own peak, so after
+// this peakRSSKilobytes is still the peak of the whole run. returns false if it is not supported
+bool resetPeakRSS();
+
+// peak resident set size since the last resetPeakRSS in kB, from VmHWM. -1 if it cannot be read
+long peakRSSSinceResetKilobytes();
+
+#endif
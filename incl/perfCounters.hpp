@@ -0,0 +1,64 @@
+#ifndef PERFCOUNTERS
+#define PERFCOUNTERS
+
+#include <string>
+
+// hardware event counters of the calling thread from perf_event_open, read around the phases the
+// benchmarks time the same way memoryAccounting reads the allocation counters: a phase reads the
+// counters at its start and subtracts that at its end, so phases can nest and the counters never
+// have to be stopped. every thread opens its own counters on its first read and they count that
+// thread only. if the kernel does not give access (perf_event_paranoid, no PMU in a VM, seccomp)
+// the phases only get their times and every count is marked as not counted
+
+enum PerfEvent
+{
+    PERF_CYCLES,
+    PERF_INSTRUCTIONS,
+    PERF_L1D_MISSES,
+    PERF_LLC_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_DTLB_MISSES,
+    PERF_EVENTS
+};
+
+// raw counter values of the calling thread at one point in time
+struct PerfReading
+{
+    long long value[PERF_EVENTS];
+    long long enabled[PERF_EVENTS];     // ns the counter was enabled, PERF_FORMAT_TOTAL_TIME_ENABLED
+    long long running[PERF_EVENTS];     // ns it was actually on the pmu, PERF_FORMAT_TOTAL_TIME_RUNNING.
+                                        // below enabled when the kernel multiplexed it, and the
+                                        // value is scaled by enabled / running
+};
+
+// what a phase counted
+struct PerfSample
+{
+    long long count[PERF_EVENTS];
+    bool counted[PERF_EVENTS];          // false if the event could not be opened
+};
+
+/* Functions */
+
+// turns collection on or off for all threads. off by default. call it before other threads start
+void setPerfCounters(bool enabled);
+bool perfCountersEnabled();
+
+// true if collection is on and the calling thread could open at least the cycle counter. the
+// first call on a thread opens its counters and prints why they could not be opened, once per run
+bool perfCountersAvailable();
+
+// starts a phase on the calling thread
+void perfPhaseStart(PerfReading& start);
+
+// the events of the calling thread since perfPhaseStart, scaled up if the kernel multiplexed them
+PerfSample perfPhaseEnd(const PerfReading& start);
+
+// short name of an event, e.g. "cycles" or "L1d-misses"
+const char* perfEventName(int event);
+
+// one line with the counts of [sample], the IPC and, if [arcs] is positive, the misses per arc
+// scanned. counts that were not collected are shown as n/a
+std::string perfSummary(const PerfSample& sample, long long arcs);
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef PLANARGRIDFLOW
+#define PLANARGRIDFLOW
+
+#include "boostGraphStruct.hpp"
+#include <vector>
+
+// max flow on the grids of generateGridInstance: n x n vertices, vertex (i, y) is y * n + i,
+// edges point right and down, s is the top left and t the bottom right vertex. both are on the
+// outer face, so splitting the outer face at s and t into an upper right and a lower left face
+// turns every s-t cut into a path between those two faces in the planar dual. crossing an
+// edge from its left face to its right face costs its capacity and crossing it back costs 0.
+// the shortest path is the min cut and its distances are potentials phi that give a max flow:
+// f(e) = phi(right face of e) - phi(left face of e). one dijkstra, O(n log n)
+struct PlanarGrid
+{
+    int n;                          // side of the grid
+
+    std::vector<Edge> rightEdge;    // (i, y) -> (i + 1, y) is rightEdge[y * (n - 1) + i]
+    std::vector<Edge> downEdge;     // (i, y) -> (i, y + 1) is downEdge[y * n + i]
+};
+
+struct PlanarGridResult
+{
+    long long flow;                 // max flow value
+    std::vector<Edge> cut;          // edges of a min cut, all from the s side to the t side
+};
+
+/* Functions */
+
+// returns true if G with source s and sink t is laid out as above and fills P
+bool recognizePlanarGrid(Graph& G, Vertex s, Vertex t, PlanarGrid& P);
+
+// max flow and min cut of the grid P. the flow is written to G[e].f
+void planarGridMaxFlow(Graph& G, const PlanarGrid& P, PlanarGridResult& result);
+
+// max flow of the grid P written to G[e].f. returns false if t is not reachable from s
+bool planarGridMaxFlow(Graph& G, const PlanarGrid& P);
+
+// MaxFlowSolver that solves the grids above through the dual and every other graph with
+// flatShortestAugmentedPath. returns false if t is not reachable from s
+bool planarGridMaxFlow(Graph& G, Vertex s, Vertex t);
+
+#endif
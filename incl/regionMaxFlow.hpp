@@ -0,0 +1,60 @@
+#ifndef REGIONMAXFLOW
+#define REGIONMAXFLOW
+
+#include "boostGraphStruct.hpp"
+#include "flatNetwork.hpp"
+#include <vector>
+
+// push-relabel by regions, after Delong and Boykov's region discharge. the vertices are split into
+// regions that are numbered consecutively in the flat network, so a region's vertices and arcs
+// stay together in memory and a region small enough fits in cache. every sweep discharges all
+// regions in parallel: a region only pushes and relabels its own vertices, reads the labels of
+// other regions as they were at the start of the sweep and keeps the flow it pushes over boundary
+// arcs in a buffer of its own, so threads never write the same memory. between sweeps the buffered
+// boundary flow is applied as excess of the neighbouring regions and the labels are made exact
+// again with one reverse bfs. the sweeps stop when no vertex that can reach t has excess, which
+// leaves a max preflow, and the excess that cannot reach t is then sent back to s
+
+// regions in the numbering of the flat network: region r is vertices first[r] .. first[r+1]-1
+struct RegionPartition
+{
+    std::vector<int> index;     // vertex v of G is vertex index[v] of the flat network
+    std::vector<int> first;     // regions + 1 offsets
+};
+
+struct RegionSolveStats
+{
+    int regions;
+    int threads;
+    int sweeps;
+    long long pushes;
+    long long relabels;
+    long long boundaryPushes;   // pushes into other regions, applied between sweeps
+    double seconds;             // wall clock time, the benchmark only counts the calling thread
+};
+
+/* Functions */
+
+// [n] x [n] grid of generateGridInstance cut into [tile] x [tile] tiles
+void gridRegions(int n, int tile, RegionPartition& P);
+
+// regions of about [regionSize] vertices grown by bfs from s over edges in both directions,
+// the vertices that are not reached from s are added by bfs from the first one left
+void bfsRegions(Graph& G, Vertex s, int regionSize, RegionPartition& P);
+
+// solves N from zero flow with [threads] threads, started once and reused by every sweep. s, t
+// and the regions are in the numbering of N
+void regionMaxFlow(FlatNetwork& N, int s, int t, const std::vector<int>& first, int threads, RegionSolveStats& stats);
+
+// threads used by the MaxFlowSolver version, the number of cores by default
+void setRegionThreads(int threads);
+
+// MaxFlowSolver version: grids are cut into tiles, other graphs into bfs regions, both sized for
+// the cache and for at least two regions per thread. returns false if t is not reachable from s
+bool regionMaxFlow(Graph& G, Vertex s, Vertex t);
+
+// statistics of the last solve of the MaxFlowSolver version, for the caller to print outside
+// of its timed region
+RegionSolveStats regionSolveStats();
+
+#endif
@@ -2,8 +2,46 @@
 #define SHORTESTAUGMENTEDPATH
 
 #include <iostream>
+#include <vector>
+#include <queue>
+#include "perfCounters.hpp"
+
+// thread cpu time in seconds spent in each phase of shortestAugmentedPath
+struct SapPhaseTimes
+{
+    float dist;                 // calcDist
+    float loop;                 // main loop without the augment steps
+    float augment;              // augment steps
+    long long augmentations;
+    long long arcsScanned;      // arcs the advance and retreat steps looked at
+    long long advances;
+    long long advanceArcs;      // arcs looked at by the advance steps that found an admissible arc,
+                                // over [advances] the position of the admissible arc in the scan
+
+    // hardware counters of calcDist and of the main loop with its augment steps, if perfCounters is on
+    PerfSample distCounters;
+    PerfSample loopCounters;
+};
+
+class SolverWorkspace;
 
 /* Functions */
+// uses the workspace of the calling thread
 bool shortestAugmentedPath(Graph& G, Vertex s, Vertex t);
 
+// same, and fills [times] if it is not NULL
+bool shortestAugmentedPath(Graph& G, Vertex s, Vertex t, SapPhaseTimes* times);
+
+// same, with the scratch buffers of [ws]
+bool shortestAugmentedPath(Graph& G, Vertex s, Vertex t, SapPhaseTimes* times, SolverWorkspace& ws);
+
+// the advance step tries all out edges of a vertex before its in edges (the simulated reverse
+// arcs). with [interleaved] it alternates between the two lists instead. off by default, call it
+// before the solver threads start
+void setInterleavedArcScan(bool interleaved);
+
+// calculates the exact distance labels to t in ws.d with a bfs over in edges. ws.d has to be -1
+// for every vertex, afterwards ws.queue holds the vertices that got a label
+void calcDist(Graph& G, Vertex t, SolverWorkspace& ws);
+
 #endif
\ No newline at end of file
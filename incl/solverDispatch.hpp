@@ -0,0 +1,78 @@
+#ifndef SOLVERDISPATCH
+#define SOLVERDISPATCH
+
+#include "boostGraphStruct.hpp"
+#include "bipartiteMatching.hpp"
+#include "planarGridFlow.hpp"
+#include <string>
+#include <vector>
+
+// picks a solver for a graph from cheap statistics of it. the graph is put in a class and the
+// solver with the lowest time per edge for that class in the calibration table is run. the table
+// is written by the baseline matrix on the machine it runs on (baselines --calibrate=PATH).
+// classes that the table does not cover fall back to a fixed choice
+
+// O(n + m) statistics of a graph
+struct GraphStatistics
+{
+    int n;
+    int m;
+    double density;         // m / (n (n - 1))
+    int minCap;
+    int maxCap;
+    int maxDegree;          // in + out
+    double degreeSkew;      // max degree / mean degree
+    bool unitCapacity;      // every capacity is 1
+    bool bipartite;         // unit capacity assignment instance of bipartiteMaxFlow
+    bool grid;              // grid of planarGridMaxFlow
+};
+
+// time per edge of one solver on one class of graphs
+struct CalibrationEntry
+{
+    std::string graphClass;
+    std::string solver;
+    double nsPerEdge;
+};
+
+struct DispatchSolver
+{
+    std::string name;
+    MaxFlowSolver solver;
+    std::string onlyClass;  // a solver specialised in one class is not calibrated or picked for others
+};
+
+/* Functions */
+
+void graphStatistics(Graph& G, Vertex s, Vertex t, GraphStatistics& stats);
+
+// the same, also keeping the network of a bipartite graph in B and the layout of a grid in P
+void graphStatistics(Graph& G, Vertex s, Vertex t, GraphStatistics& stats, BipartiteNetwork& B, PlanarGrid& P);
+
+// bipartite, grid, dense, skewed or sparse, checked in that order
+std::string graphClass(const GraphStatistics& stats);
+
+// the solvers the dispatcher can pick from, by name
+const std::vector<DispatchSolver>& dispatchSolvers();
+
+// whether [solver] can be picked for graphs of class [graphClass]
+bool solverFitsClass(const DispatchSolver& solver, const std::string& graphClass);
+
+// reads "class solver nsPerEdge" lines. returns false if the file cannot be opened
+bool readCalibration(const std::string& path, std::vector<CalibrationEntry>& table);
+
+bool writeCalibration(const std::string& path, const std::vector<CalibrationEntry>& table);
+
+// file the calibration table is read from on the first dispatch, dispatch.calibration by default
+void setCalibrationFile(const std::string& path);
+
+// whether dispatchMaxFlow prints its choice, true by default
+void setDispatchLog(bool log);
+
+// the solver for [stats] and the reason it was picked
+const DispatchSolver& chooseSolver(const GraphStatistics& stats, std::string& reason);
+
+// MaxFlowSolver that computes the statistics of G, picks a solver, logs the pick and runs it
+bool dispatchMaxFlow(Graph& G, Vertex s, Vertex t);
+
+#endif
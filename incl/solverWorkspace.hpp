@@ -0,0 +1,60 @@
+#ifndef SOLVERWORKSPACE
+#define SOLVERWORKSPACE
+
+#include "boostGraphStruct.hpp"
+#include "flatNetwork.hpp"
+#include <vector>
+#include <algorithm>
+
+// scratch buffers of shortestAugmentedPath, flatShortestAugmentedPath and CHECK_MAX_FLOW_T kept
+// between calls, so that a stream of small queries does not go through the allocator on every
+// call. the buffers only grow, to the largest graph seen. marks are epoch stamps: a vertex is
+// marked if its stamp equals the current epoch, so starting a new search is one increment instead
+// of refilling n entries. arrays that are not stamped are either written before they are read or
+// put back in O(touched) by the solver that changed them
+class SolverWorkspace
+{
+public:
+    SolverWorkspace() : epoch(0) {}
+
+    // makes room for a graph with n vertices and m edges
+    void reserve(int n, int m);
+
+    // unmarks every vertex
+    void newEpoch(){
+        if (++epoch == 0){
+            // after 2^32 searches the old stamps could match again
+            std::fill(stamp.begin(), stamp.end(), 0);
+            epoch = 1;
+        }
+    }
+
+    bool marked(int v) const { return stamp[v] == epoch; }
+    void mark(int v){ stamp[v] = epoch; }
+
+    // shortestAugmentedPath. d is -1 for every vertex between calls
+    std::vector<int> d;
+    std::vector<Vertex> pred;
+    std::vector<char> predIsReal;
+    std::vector<Vertex> queue;          // bfs queue, the vertices in the order they were found
+    std::vector<Edge> pathEdges;        // edges of the augmenting path and whether they gain flow
+    std::vector<char> addFlow;
+
+    // flatShortestAugmentedPath
+    FlatNetwork network;
+    BulkVector<int> labels;
+    BulkVector<int> count;
+    BulkVector<int> current;
+    BulkVector<int> arcPred;
+
+private:
+    std::vector<unsigned int> stamp;
+    unsigned int epoch;
+};
+
+/* Functions */
+
+// workspace of the calling thread, used by the solver versions that do not take one
+SolverWorkspace& threadWorkspace();
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef THREADTIME
+#define THREADTIME
+
+/* Functions */
+
+// cpu time of the calling thread in seconds. used instead of leda::used_time which
+// measures the whole process and would also count the producer threads
+float threadTime();
+
+// same semantics as leda::used_time(T): returns the time elapsed since [start_T]
+// and sets [start_T] to the current time
+float threadTime(float& start_T);
+
+#endif
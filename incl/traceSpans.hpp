@@ -0,0 +1,60 @@
+#ifndef TRACESPANS
+#define TRACESPANS
+
+#include <string>
+#include <cstdint>
+
+// timeline of the benchmark in the Chrome trace format (chrome://tracing, ui.perfetto.dev). a
+// TRACE_SPAN records the time from where it is declared to the end of its scope. every thread
+// records into a ring buffer of its own, so recording takes no lock and a long run keeps its last
+// TRACE_EVENTS_PER_THREAD spans per thread. the spans are only compiled in with -DADST_TRACE
+// (make compile TRACEFLAGS=-DADST_TRACE); without it TRACE_SPAN is an empty statement
+
+// spans kept per thread, older ones are overwritten
+const int TRACE_EVENTS_PER_THREAD = 1 << 16;
+
+/* Functions */
+
+// nanoseconds on the steady clock since the first call
+int64_t traceNow();
+
+// adds a span of the calling thread. [name] has to live until the trace is written
+void traceRecord(const char* name, int64_t start, int64_t end);
+
+// name of the calling thread in the trace
+void traceThreadName(const std::string& name);
+
+// writes the spans of all threads as Chrome trace JSON. the threads that record spans must not
+// run while it is called. returns false if the file cannot be written
+bool writeTrace(const std::string& path);
+
+// whether this build records spans
+bool traceCompiledIn();
+
+#ifdef ADST_TRACE
+
+class TraceSpan
+{
+public:
+    TraceSpan(const char* name) : name(name), start(traceNow()) {}
+    ~TraceSpan(){ traceRecord(name, start, traceNow()); }
+
+private:
+    const char* name;
+    int64_t start;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+#define TRACE_SPAN(name) TraceSpan TRACE_CONCAT(traceSpan, __LINE__)(name)
+#define TRACE_THREAD_NAME(name) traceThreadName(name)
+
+#else
+
+#define TRACE_SPAN(name) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+
+#endif
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef VERTEXREORDERING
+#define VERTEXREORDERING
+
+#include "boostGraphStruct.hpp"
+#include <vector>
+#include <utility>
+
+// vertex orders that reorderVertices can relabel a graph into
+enum VertexOrder
+{
+    ORDER_NONE,         // keep the ids of the input graph
+    ORDER_REVERSE_BFS,  // order in which a bfs over in edges from t discovers the vertices, like calcDist
+    ORDER_RCM           // reverse Cuthill-McKee on the undirected view of the graph
+};
+
+// relabeled copy of a graph and the mapping back to the ids of the caller
+struct ReorderedGraph
+{
+    Graph G;
+    Vertex s;
+    Vertex t;
+
+    // reordered vertex -> vertex of the original graph
+    std::vector<Vertex> originalVertex;
+
+    // (edge of the original graph, edge of G)
+    std::vector<std::pair<Edge, Edge> > edgeMap;
+};
+
+/* Functions */
+
+// stores in [order] the vertices of G in the requested order. order[k] is the vertex that gets id k
+void computeVertexOrder(Graph& G, Vertex t, VertexOrder vertexOrder, std::vector<Vertex>& order);
+
+// builds in R a copy of G with the vertices relabeled in [vertexOrder]. the adjacency is
+// rebuilt in the new order too, so the edges of neighbouring vertices are allocated together
+void reorderVertices(Graph& G, Vertex s, Vertex t, VertexOrder vertexOrder, ReorderedGraph& R);
+
+// copies the flow found on R.G back to the edges of G
+void expandReorderedFlow(Graph& G, const ReorderedGraph& R);
+
+#endif
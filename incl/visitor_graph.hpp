@@ -5,7 +5,6 @@
 #include "shortestAugmentedPath.hpp"
 #include <boost/graph/depth_first_search.hpp>
 #include <boost/shared_ptr.hpp>
-#include <LEDA/graph/graph.h>
 #include <vector>
 
 using namespace boost;
@@ -0,0 +1,119 @@
+#include <iostream>
+#include "boostGraphStruct.hpp"
+#include "anytimeMaxFlow.hpp"
+#include "flatShortestAugmentedPath.hpp"
+#include <climits>
+#include <algorithm>
+
+using namespace boost;
+
+double anytimeEpsilon = 0.01;
+
+
+void anytimeMaxFlow(FlatNetwork& N, int s, int t, double epsilon, AnytimeBounds& bounds, long long checkEvery){
+
+    bounds.lower = 0;
+    bounds.upper = LLONG_MAX;
+    bounds.exact = false;
+    bounds.augmentations = 0;
+    bounds.checks = 0;
+
+    bool stopped = false;
+
+    FlatSolverMonitor monitor;
+    monitor.every = checkEvery > 0 ? checkEvery : std::max(2 * N.m, 1000);
+    monitor.check = [&](const FlatSolveProgress& progress){
+
+        long long upper = flatLabelCutBound(N, s, *progress.d, progress.flow);
+        if (upper < bounds.upper) bounds.upper = upper;
+
+        bounds.lower = progress.flow;
+        bounds.augmentations = progress.augmentations;
+        bounds.checks++;
+
+        // the gap is small enough
+        if (bounds.upper - bounds.lower <= epsilon * bounds.upper) stopped = true;
+
+        return !stopped;
+    };
+
+    flatShortestAugmentedPath(N, s, t, &monitor);
+
+    if (!stopped){
+        bounds.lower = flatFlowValue(N, s);
+        bounds.upper = bounds.lower;
+        bounds.exact = true;
+    }
+
+}
+
+bool anytimeMaxFlow(Graph& G, Vertex s, Vertex t, double epsilon, AnytimeBounds& bounds){
+
+    EdgeIterator e_it, e_it_end;
+
+    // flow = 0
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+        G[*e_it].f = 0;
+    }
+
+    FlatNetwork N;
+    buildFlatNetwork(G, N);
+
+    BulkVector<int> d;
+    flatExactLabels(N, t, d);
+
+    if (d[s] >= N.n){
+        std::cout<<"t is not reachable from s"<<std::endl;
+        return false;
+    }
+
+    anytimeMaxFlow(N, s, t, epsilon, bounds);
+
+    writeFlatFlow(G, N);
+
+    return true;
+
+}
+
+long long flatLabelCutBound(const FlatNetwork& N, int s, const BulkVector<int>& d, long long flow){
+
+    int n = N.n;
+    int top = std::min(d[s], n);
+
+    // residual leaving the cut {v : d[v] >= k}, summed into out[k]
+    std::vector<long long> out(top + 1, 0);
+
+    for (int v = 0; v < n; v++){
+        int k = d[v];
+        if (k < 1 || k > top) continue;
+        for (int a = N.first[v]; a < N.first[v + 1]; a++){
+            if (N.residual[a] > 0 && d[N.head[a]] == k - 1) out[k] += N.residual[a];
+        }
+    }
+
+    long long best = LLONG_MAX;
+    for (int k = 1; k <= top; k++){
+        if (out[k] < best) best = out[k];
+    }
+
+    return best == LLONG_MAX ? flow : flow + best;
+
+}
+
+void setAnytimeEpsilon(double epsilon){
+    anytimeEpsilon = epsilon;
+}
+
+bool anytimeMaxFlow(Graph& G, Vertex s, Vertex t){
+
+    AnytimeBounds bounds;
+
+    if (!anytimeMaxFlow(G, s, t, anytimeEpsilon, bounds)) return false;
+
+    std::cout<<"anytimeMaxFlow: flow "<<bounds.lower<<", max flow at most "<<bounds.upper;
+    if (bounds.exact) std::cout<<" (exact)";
+    std::cout<<", "<<bounds.checks<<" bound refreshes"<<std::endl;
+
+    return true;
+
+}
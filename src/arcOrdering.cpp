@@ -0,0 +1,71 @@
+#include "boostGraphStruct.hpp"
+#include "arcOrdering.hpp"
+#include "shortestAugmentedPath.hpp"
+#include "solverWorkspace.hpp"
+#include <vector>
+#include <climits>
+
+using namespace boost;
+
+typedef Graph::StoredEdge StoredEdge;
+
+
+void orderArcs(Graph& G, Vertex t, ArcOrder arcOrder){
+
+    int n = num_vertices(G);
+
+    if (arcOrder == ARC_ORDER_DISTANCE){
+        // the labels SAP starts with. vertices the bfs does not reach get INT_MAX and go last
+        SolverWorkspace& ws = threadWorkspace();
+        ws.reserve(n, num_edges(G));
+        calcDist(G, t, ws);
+
+        std::vector<int> label(n, INT_MAX);
+        for (size_t q = 0; q < ws.queue.size(); q++){
+            Vertex v = ws.queue[q];
+            label[v] = ws.d[v];
+            ws.d[v] = -1;
+        }
+
+        // the stored edge of an out edge list holds the target and the one of an in edge list
+        // the source, so both sort by the label of the other end
+        auto byLabel = [&](const StoredEdge& x, const StoredEdge& y){ return label[x.get_target()] < label[y.get_target()]; };
+
+        for (int v = 0; v < n; v++){
+            G.out_edge_list(v).sort(byLabel);
+            in_edge_list(G, v).sort(byLabel);
+        }
+    }
+    else if (arcOrder == ARC_ORDER_CAPACITY){
+        // at zero flow the residual of an out edge is its capacity, and the capacity is what an
+        // in edge can give back once it carries flow
+        auto byCapacity = [](const StoredEdge& x, const StoredEdge& y){ return x.get_property().cap > y.get_property().cap; };
+
+        for (int v = 0; v < n; v++){
+            G.out_edge_list(v).sort(byCapacity);
+            in_edge_list(G, v).sort(byCapacity);
+        }
+    }
+
+}
+
+const char* arcOrderName(ArcOrder arcOrder){
+
+    static const char* names[] = {"none", "distance", "capacity", "interleave"};
+
+    return names[arcOrder];
+
+}
+
+bool parseArcOrder(const std::string& name, ArcOrder& arcOrder){
+
+    for (int k = ARC_ORDER_NONE; k <= ARC_ORDER_INTERLEAVE; k++){
+        if (name == arcOrderName((ArcOrder)k)){
+            arcOrder = (ArcOrder)k;
+            return true;
+        }
+    }
+
+    return false;
+
+}
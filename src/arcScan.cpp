@@ -0,0 +1,212 @@
+#include "arcScan.hpp"
+#include <climits>
+#include <immintrin.h>
+
+int admissibleArcScanScalar(const int* head, const int* residual, const int* label, int begin, int end, int wanted);
+int admissibleArcScanAVX2(const int* head, const int* residual, const int* label, int begin, int end, int wanted);
+int admissibleArcScanAVX512(const int* head, const int* residual, const int* label, int begin, int end, int wanted);
+
+int minLabelScanScalar(const int* head, const int* residual, const int* label, int begin, int end);
+int minLabelScanAVX2(const int* head, const int* residual, const int* label, int begin, int end);
+int minLabelScanAVX512(const int* head, const int* residual, const int* label, int begin, int end);
+
+// the first call through the kernel pointers selects the kernels and forwards the call
+int admissibleArcScanResolve(const int* head, const int* residual, const int* label, int begin, int end, int wanted);
+int minLabelScanResolve(const int* head, const int* residual, const int* label, int begin, int end);
+
+AdmissibleArcScan admissibleArcScan = admissibleArcScanResolve;
+MinLabelScan minLabelScan = minLabelScanResolve;
+
+static ArcScanKernel selectedKernel = SCAN_AUTO;
+
+
+ArcScanKernel setArcScanKernel(ArcScanKernel kernel){
+
+    __builtin_cpu_init();
+
+    bool hasAVX512 = __builtin_cpu_supports("avx512f");
+    bool hasAVX2 = __builtin_cpu_supports("avx2");
+
+    if (kernel == SCAN_AUTO) kernel = SCAN_AVX512;
+    if (kernel == SCAN_AVX512 && !hasAVX512) kernel = SCAN_AVX2;
+    if (kernel == SCAN_AVX2 && !hasAVX2) kernel = SCAN_SCALAR;
+
+    switch (kernel){
+        case SCAN_AVX512:
+            admissibleArcScan = admissibleArcScanAVX512;
+            minLabelScan = minLabelScanAVX512;
+            break;
+        case SCAN_AVX2:
+            admissibleArcScan = admissibleArcScanAVX2;
+            minLabelScan = minLabelScanAVX2;
+            break;
+        default:
+            admissibleArcScan = admissibleArcScanScalar;
+            minLabelScan = minLabelScanScalar;
+            break;
+    }
+
+    selectedKernel = kernel;
+    return kernel;
+
+}
+
+ArcScanKernel arcScanKernel(){
+    if (selectedKernel == SCAN_AUTO) setArcScanKernel(SCAN_AUTO);
+    return selectedKernel;
+}
+
+const char* arcScanKernelName(ArcScanKernel kernel){
+    switch (kernel){
+        case SCAN_SCALAR: return "scalar";
+        case SCAN_AVX2: return "avx2";
+        case SCAN_AVX512: return "avx512";
+        default: return "auto";
+    }
+}
+
+int admissibleArcScanResolve(const int* head, const int* residual, const int* label, int begin, int end, int wanted){
+    setArcScanKernel(SCAN_AUTO);
+    return admissibleArcScan(head, residual, label, begin, end, wanted);
+}
+
+int minLabelScanResolve(const int* head, const int* residual, const int* label, int begin, int end){
+    setArcScanKernel(SCAN_AUTO);
+    return minLabelScan(head, residual, label, begin, end);
+}
+
+
+// scalar
+
+int admissibleArcScanScalar(const int* head, const int* residual, const int* label, int begin, int end, int wanted){
+
+    for (int a = begin; a < end; a++){
+        if (residual[a] > 0 && label[head[a]] == wanted) return a;
+    }
+    return end;
+
+}
+
+int minLabelScanScalar(const int* head, const int* residual, const int* label, int begin, int end){
+
+    int mind = INT_MAX;
+    for (int a = begin; a < end; a++){
+        if (residual[a] > 0 && label[head[a]] < mind) mind = label[head[a]];
+    }
+    return mind;
+
+}
+
+
+// AVX2: 8 arcs at a time. labels are only gathered for arcs with residual > 0,
+// the other lanes get a value that can never match (labels are never negative)
+
+__attribute__((target("avx2")))
+int admissibleArcScanAVX2(const int* head, const int* residual, const int* label, int begin, int end, int wanted){
+
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i none = _mm256_set1_epi32(-1);
+    const __m256i want = _mm256_set1_epi32(wanted);
+
+    int a = begin;
+
+    for (; a + 8 <= end; a += 8){
+        __m256i r = _mm256_loadu_si256((const __m256i*)(residual + a));
+        __m256i open = _mm256_cmpgt_epi32(r, zero);
+        if (_mm256_testz_si256(open, open)) continue;
+
+        __m256i h = _mm256_loadu_si256((const __m256i*)(head + a));
+        __m256i d = _mm256_mask_i32gather_epi32(none, label, h, open, 4);
+
+        int bits = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(d, want)));
+        if (bits) return a + __builtin_ctz(bits);
+    }
+
+    return admissibleArcScanScalar(head, residual, label, a, end, wanted);
+
+}
+
+__attribute__((target("avx2")))
+int minLabelScanAVX2(const int* head, const int* residual, const int* label, int begin, int end){
+
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i none = _mm256_set1_epi32(INT_MAX);
+
+    __m256i acc = none;
+    int a = begin;
+
+    for (; a + 8 <= end; a += 8){
+        __m256i r = _mm256_loadu_si256((const __m256i*)(residual + a));
+        __m256i open = _mm256_cmpgt_epi32(r, zero);
+        if (_mm256_testz_si256(open, open)) continue;
+
+        __m256i h = _mm256_loadu_si256((const __m256i*)(head + a));
+        __m256i d = _mm256_mask_i32gather_epi32(none, label, h, open, 4);
+        acc = _mm256_min_epi32(acc, d);
+    }
+
+    // horizontal min of the 8 lanes
+    __m128i low = _mm_min_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+    low = _mm_min_epi32(low, _mm_shuffle_epi32(low, _MM_SHUFFLE(1, 0, 3, 2)));
+    low = _mm_min_epi32(low, _mm_shuffle_epi32(low, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    int mind = _mm_cvtsi128_si32(low);
+    int rest = minLabelScanScalar(head, residual, label, a, end);
+
+    return rest < mind ? rest : mind;
+
+}
+
+
+// AVX-512: 16 arcs at a time with mask registers
+
+__attribute__((target("avx512f")))
+int admissibleArcScanAVX512(const int* head, const int* residual, const int* label, int begin, int end, int wanted){
+
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i none = _mm512_set1_epi32(-1);
+    const __m512i want = _mm512_set1_epi32(wanted);
+
+    int a = begin;
+
+    for (; a + 16 <= end; a += 16){
+        __m512i r = _mm512_loadu_si512((const void*)(residual + a));
+        __mmask16 open = _mm512_cmpgt_epi32_mask(r, zero);
+        if (!open) continue;
+
+        __m512i h = _mm512_loadu_si512((const void*)(head + a));
+        __m512i d = _mm512_mask_i32gather_epi32(none, open, h, label, 4);
+
+        __mmask16 hit = _mm512_mask_cmpeq_epi32_mask(open, d, want);
+        if (hit) return a + __builtin_ctz(hit);
+    }
+
+    return admissibleArcScanAVX2(head, residual, label, a, end, wanted);
+
+}
+
+__attribute__((target("avx512f")))
+int minLabelScanAVX512(const int* head, const int* residual, const int* label, int begin, int end){
+
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i none = _mm512_set1_epi32(INT_MAX);
+
+    __m512i acc = none;
+    int a = begin;
+
+    for (; a + 16 <= end; a += 16){
+        __m512i r = _mm512_loadu_si512((const void*)(residual + a));
+        __mmask16 open = _mm512_cmpgt_epi32_mask(r, zero);
+        if (!open) continue;
+
+        __m512i h = _mm512_loadu_si512((const void*)(head + a));
+        __m512i d = _mm512_mask_i32gather_epi32(none, open, h, label, 4);
+        acc = _mm512_min_epi32(acc, d);
+    }
+
+    int mind = _mm512_reduce_min_epi32(acc);
+    int rest = minLabelScanAVX2(head, residual, label, a, end);
+
+    return rest < mind ? rest : mind;
+
+}
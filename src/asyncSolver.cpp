@@ -0,0 +1,232 @@
+#include "boostGraphStruct.hpp"
+#include "asyncSolver.hpp"
+#include "flatShortestAugmentedPath.hpp"
+#include "threadTime.hpp"
+#include <thread>
+#include <climits>
+#include <algorithm>
+
+using namespace boost;
+
+// deadline of deadlineMaxFlow, 100 ms by default
+long long solveDeadlineNs = 100000000;
+
+AsyncSolveStats lastStats = {SOLVE_DONE, 0, 0, 0};
+
+
+SolveControl::SolveControl(long long checkEvery) : every(checkEvery > 0 ? checkEvery : 1), cancelled(false), deadlineNs(LLONG_MAX),
+    sequence(0), flow(0), sourceLabel(0), iterations(0), augmentations(0), running(true), reason(SOLVE_DONE) {}
+
+void SolveControl::cancel(){
+    cancelled.store(true, std::memory_order_relaxed);
+}
+
+void SolveControl::setDeadline(std::chrono::steady_clock::time_point deadline){
+    long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+    deadlineNs.store(ns, std::memory_order_relaxed);
+}
+
+SolveSnapshot SolveControl::progress() const{
+
+    SolveSnapshot snapshot;
+    unsigned before, after;
+
+    do {
+        before = sequence.load(std::memory_order_acquire);
+        snapshot.flow = flow.load(std::memory_order_relaxed);
+        snapshot.sourceLabel = sourceLabel.load(std::memory_order_relaxed);
+        snapshot.iterations = iterations.load(std::memory_order_relaxed);
+        snapshot.augmentations = augmentations.load(std::memory_order_relaxed);
+        snapshot.running = running.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        after = sequence.load(std::memory_order_relaxed);
+    } while (before != after || (before & 1));
+
+    return snapshot;
+
+}
+
+bool SolveControl::check(const SolveSnapshot& snapshot){
+
+    publish(snapshot);
+
+    if (cancelled.load(std::memory_order_relaxed)){
+        reason = SOLVE_CANCELLED;
+        return false;
+    }
+
+    long long deadline = deadlineNs.load(std::memory_order_relaxed);
+    if (deadline != LLONG_MAX){
+        long long now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        if (now >= deadline){
+            reason = SOLVE_DEADLINE;
+            return false;
+        }
+    }
+
+    return true;
+
+}
+
+void SolveControl::finish(const SolveSnapshot& snapshot){
+    publish(snapshot);
+}
+
+void SolveControl::publish(const SolveSnapshot& snapshot){
+
+    // only the worker writes, so a plain increment is enough to mark the snapshot as being written
+    unsigned seq = sequence.load(std::memory_order_relaxed);
+    sequence.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    flow.store(snapshot.flow, std::memory_order_relaxed);
+    sourceLabel.store(snapshot.sourceLabel, std::memory_order_relaxed);
+    iterations.store(snapshot.iterations, std::memory_order_relaxed);
+    augmentations.store(snapshot.augmentations, std::memory_order_relaxed);
+    running.store(snapshot.running, std::memory_order_relaxed);
+
+    sequence.store(seq + 2, std::memory_order_release);
+
+}
+
+
+AsyncSolve::AsyncSolve(std::thread worker, std::future<AsyncSolveResult> result, std::shared_ptr<SolveControl> control)
+    : worker(std::move(worker)), result(std::move(result)), ctrl(control) {}
+
+AsyncSolve& AsyncSolve::operator=(AsyncSolve&& other){
+    if (this != &other){
+        release();
+        worker = std::move(other.worker);
+        result = std::move(other.result);
+        ctrl = std::move(other.ctrl);
+    }
+    return *this;
+}
+
+AsyncSolve::~AsyncSolve(){
+    release();
+}
+
+void AsyncSolve::release(){
+    if (!worker.joinable()) return;
+    ctrl->cancel();
+    worker.join();
+}
+
+bool AsyncSolve::waitFor(std::chrono::milliseconds timeout){
+    return result.wait_for(timeout) == std::future_status::ready;
+}
+
+AsyncSolveResult AsyncSolve::get(){
+    AsyncSolveResult solved = result.get();
+    worker.join();
+    return solved;
+}
+
+
+AsyncSolve solveAsync(FlatNetwork N, int s, int t, std::shared_ptr<SolveControl> control){
+
+    std::shared_ptr<std::promise<AsyncSolveResult> > promise(new std::promise<AsyncSolveResult>());
+    std::future<AsyncSolveResult> future = promise->get_future();
+
+    std::shared_ptr<FlatNetwork> network(new FlatNetwork(std::move(N)));
+
+    std::thread worker([network, s, t, control, promise](){
+
+        float start_T = threadTime();
+
+        SolveSnapshot last;
+        last.flow = 0;
+        last.sourceLabel = 0;
+        last.iterations = 0;
+        last.augmentations = 0;
+        last.running = true;
+
+        bool stopped = false;
+
+        FlatSolverMonitor monitor;
+        monitor.every = control->checkEvery();
+        monitor.check = [&](const FlatSolveProgress& progress){
+            last.flow = progress.flow;
+            last.sourceLabel = progress.sourceLabel;
+            last.iterations = progress.iterations;
+            last.augmentations = progress.augmentations;
+            if (control->check(last)) return true;
+            stopped = true;
+            return false;
+        };
+
+        AsyncSolveResult result;
+        result.status = SOLVE_DONE;
+
+        if (!flatShortestAugmentedPath(*network, s, t, &monitor)) result.status = SOLVE_UNREACHABLE;
+        else if (stopped) result.status = control->stopReason();
+
+        result.flow = flatFlowValue(*network, s);
+        result.network = std::move(*network);
+        result.cpuTime = threadTime(start_T);
+
+        last.flow = result.flow;
+        last.running = false;
+        control->finish(last);
+
+        promise->set_value(std::move(result));
+    });
+
+    return AsyncSolve(std::move(worker), std::move(future), control);
+
+}
+
+AsyncSolve solveAsync(Graph& G, Vertex s, Vertex t, std::shared_ptr<SolveControl> control){
+
+    EdgeIterator e_it, e_it_end;
+
+    // flow = 0
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+        G[*e_it].f = 0;
+    }
+
+    FlatNetwork N;
+    buildFlatNetwork(G, N);
+
+    return solveAsync(std::move(N), s, t, control);
+
+}
+
+void setSolveDeadline(double milliseconds){
+    solveDeadlineNs = (long long)(milliseconds * 1e6);
+}
+
+bool deadlineMaxFlow(Graph& G, Vertex s, Vertex t){
+
+    std::shared_ptr<SolveControl> control(new SolveControl());
+    control->setDeadline(std::chrono::steady_clock::now() + std::chrono::nanoseconds(solveDeadlineNs));
+
+    AsyncSolve solve = solveAsync(G, s, t, control);
+
+    // the progress is read about ten times per deadline, as a caller showing it would
+    std::chrono::milliseconds poll(std::max(1LL, solveDeadlineNs / 10000000));
+
+    lastStats.polls = 0;
+    while (!solve.waitFor(poll)){
+        solve.control().progress();
+        lastStats.polls++;
+    }
+
+    AsyncSolveResult result = solve.get();
+
+    lastStats.status = result.status;
+    lastStats.flow = result.flow;
+    lastStats.cpuTime = result.cpuTime;
+
+    if (result.status == SOLVE_UNREACHABLE) return false;
+
+    writeFlatFlow(G, result.network);
+
+    return true;
+
+}
+
+AsyncSolveStats asyncSolveStats(){
+    return lastStats;
+}
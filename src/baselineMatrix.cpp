@@ -0,0 +1,306 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdio>
+#include "boostGraphStruct.hpp"
+#include "checkMaxFlow.hpp"
+#include "shortestAugmentedPath.hpp"
+#include "flatShortestAugmentedPath.hpp"
+#include "boostBaselines.hpp"
+#include "solverDispatch.hpp"
+#include "threadTime.hpp"
+#include "graphGenerators.hpp"
+#include "compressedNetwork.hpp"
+
+using namespace boost;
+
+// runs every solver on the same fixed seed instances and prints a solver by instance table of
+// times and flow values. every flow is checked with CHECK_MAX_FLOW_T and compared with the flow
+// value of the first solver, so a fast but wrong solver shows up in the table. with
+// --calibrate=PATH the times per edge of every solver are averaged per graph class and written as
+// the calibration table of solverDispatch. with --compression the bytes per edge of the flat and
+// the compressed network and the time of the same cursor solver on both are printed for every
+// instance, which is the decode cost of the compressed format. does not need LEDA
+
+enum MatrixInstanceKind {RANDOM_INSTANCE, GRID_INSTANCE, BIPARTITE_INSTANCE, AK_INSTANCE, GENRMF_INSTANCE, WASHINGTON_INSTANCE, RMAT_INSTANCE};
+
+// capacity range of the edges between GENRMF frames
+const int GENRMF_MIN_CAP = 1;
+const int GENRMF_MAX_CAP = 10000;
+
+struct MatrixInstance
+{
+    std::string name;
+    MatrixInstanceKind kind;
+    int n;
+    int m;
+    unsigned seed;
+};
+
+// flow value leaving s
+long flowValue(Graph& G, Vertex s);
+
+// bytes per edge and cursor solver times of the flat and the compressed network of G
+void printCompression(const std::string& name, Graph& G, Vertex s, Vertex t, int repetitions);
+
+
+int main(int argc, char* argv[])
+{
+
+    int repetitions = 1;
+    std::string calibrationPath;
+    bool compression = false;
+    unsigned seed = 1;
+
+    std::vector<MatrixInstance> instances;
+
+    for (int a = 1; a < argc; a++){
+        std::string arg = argv[a];
+
+        if (arg.compare(0, 14, "--repetitions=") == 0) repetitions = atoi(arg.c_str() + 14);
+        else if (arg.compare(0, 12, "--calibrate=") == 0) calibrationPath = arg.substr(12);
+        else if (arg == "--compression") compression = true;
+        else if (arg.compare(0, 9, "--random=") == 0){
+            // --random=N,M
+            MatrixInstance inst = {"", RANDOM_INSTANCE, 0, 0, seed};
+            if (sscanf(arg.c_str() + 9, "%d,%d", &inst.n, &inst.m) != 2){
+                std::cout<<"Expected --random=N,M"<<std::endl;
+                return 1;
+            }
+            inst.name = "random-" + arg.substr(9);
+            instances.push_back(inst);
+        }
+        else if (arg.compare(0, 7, "--grid=") == 0){
+            MatrixInstance inst = {"grid-" + arg.substr(7), GRID_INSTANCE, atoi(arg.c_str() + 7), 0, seed};
+            instances.push_back(inst);
+        }
+        else if (arg.compare(0, 12, "--bipartite=") == 0){
+            // --bipartite=N,M : N left and N right vertices, M edges between them
+            MatrixInstance inst = {"", BIPARTITE_INSTANCE, 0, 0, seed};
+            if (sscanf(arg.c_str() + 12, "%d,%d", &inst.n, &inst.m) != 2){
+                std::cout<<"Expected --bipartite=N,M"<<std::endl;
+                return 1;
+            }
+            inst.name = "bipartite-" + arg.substr(12);
+            instances.push_back(inst);
+        }
+        else if (arg.compare(0, 5, "--ak=") == 0){
+            MatrixInstance inst = {"ak-" + arg.substr(5), AK_INSTANCE, atoi(arg.c_str() + 5), 0, seed};
+            instances.push_back(inst);
+        }
+        else if (arg.compare(0, 9, "--genrmf=") == 0){
+            // --genrmf=A,B : B frames of A x A
+            MatrixInstance inst = {"", GENRMF_INSTANCE, 0, 0, seed};
+            if (sscanf(arg.c_str() + 9, "%d,%d", &inst.n, &inst.m) != 2){
+                std::cout<<"Expected --genrmf=A,B"<<std::endl;
+                return 1;
+            }
+            inst.name = "genrmf-" + arg.substr(9);
+            instances.push_back(inst);
+        }
+        else if (arg.compare(0, 13, "--washington=") == 0){
+            // --washington=R,L : L levels of R vertices
+            MatrixInstance inst = {"", WASHINGTON_INSTANCE, 0, 0, seed};
+            if (sscanf(arg.c_str() + 13, "%d,%d", &inst.n, &inst.m) != 2){
+                std::cout<<"Expected --washington=R,L"<<std::endl;
+                return 1;
+            }
+            inst.name = "washington-" + arg.substr(13);
+            instances.push_back(inst);
+        }
+        else if (arg.compare(0, 7, "--rmat=") == 0){
+            // --rmat=SCALE,EDGEFACTOR : 2^SCALE vertices, EDGEFACTOR edges per vertex
+            MatrixInstance inst = {"", RMAT_INSTANCE, 0, 0, seed};
+            if (sscanf(arg.c_str() + 7, "%d,%d", &inst.n, &inst.m) != 2){
+                std::cout<<"Expected --rmat=SCALE,EDGEFACTOR"<<std::endl;
+                return 1;
+            }
+            inst.name = "rmat-" + arg.substr(7);
+            instances.push_back(inst);
+        }
+        else if (arg.compare(0, 7, "--seed=") == 0){
+            // seed of the instances given after it
+            seed = atoi(arg.c_str() + 7);
+        }
+        else{
+            std::cout<<"Unknown option: "<<arg<<std::endl;
+            return 1;
+        }
+    }
+
+    if (repetitions < 1) repetitions = 1;
+
+    if (instances.empty()){
+        instances.push_back({"random-1000,8000", RANDOM_INSTANCE, 1000, 8000, 1});
+        instances.push_back({"random-2000,10000", RANDOM_INSTANCE, 2000, 10000, 3});
+        instances.push_back({"random-300,30000", RANDOM_INSTANCE, 300, 30000, 1});
+        instances.push_back({"grid-60", GRID_INSTANCE, 60, 0, 3});
+        instances.push_back({"bipartite-2000,20000", BIPARTITE_INSTANCE, 2000, 20000, 1});
+    }
+
+    // the solvers solverDispatch picks from. bipartiteMaxFlow and planarGridMaxFlow run
+    // flatShortestAugmentedPath on the instances they do not specialise in
+    const std::vector<DispatchSolver>& solvers = dispatchSolvers();
+
+    // table[solver][instance]
+    std::vector<std::vector<std::string> > table(solvers.size(), std::vector<std::string>(instances.size()));
+    bool allCorrect = true;
+
+    // summed ns per edge and number of instances of every class and solver
+    std::map<std::pair<std::string, std::string>, std::pair<double, int> > perClass;
+
+    for (size_t i = 0; i < instances.size(); i++){
+
+        Graph G;
+        Vertex s, t;
+
+        const MatrixInstance& inst = instances[i];
+
+        if (inst.kind == GRID_INSTANCE) generateGridGraph(G, inst.n, inst.seed, s, t);
+        else if (inst.kind == BIPARTITE_INSTANCE) generateBipartiteGraph(G, inst.n, inst.m, inst.seed, s, t);
+        else if (inst.kind == AK_INSTANCE) generateAKGraph(G, inst.n, s, t);
+        else if (inst.kind == GENRMF_INSTANCE) generateGenrmfGraph(G, inst.n, inst.m, GENRMF_MIN_CAP, GENRMF_MAX_CAP, inst.seed, s, t);
+        else if (inst.kind == WASHINGTON_INSTANCE) generateWashingtonGraph(G, inst.n, inst.m, inst.seed, s, t);
+        else if (inst.kind == RMAT_INSTANCE) generateRmatGraph(G, inst.n, inst.m, inst.seed, s, t);
+        else generateRandomGraph(G, inst.n, inst.m, inst.seed, s, t);
+
+        GraphStatistics stats;
+        graphStatistics(G, s, t, stats);
+        std::string cls = graphClass(stats);
+
+        long reference = 0;
+
+        for (size_t k = 0; k < solvers.size(); k++){
+
+            // fastest of the repetitions. every solver starts from zero flow on its own
+            float best = 0;
+            float T = 0;
+
+            for (int r = 0; r < repetitions; r++){
+                threadTime(T);
+                solvers[k].solver(G, s, t);
+                float finish_T = threadTime(T);
+                if (r == 0 || finish_T < best) best = finish_T;
+            }
+
+            long value = flowValue(G, s);
+            if (k == 0) reference = value;
+
+            bool correct = CHECK_MAX_FLOW_T(G, s, t, false) && value == reference;
+            if (!correct) allCorrect = false;
+            else if (solverFitsClass(solvers[k], cls)){
+                std::pair<double, int>& sum = perClass[std::make_pair(cls, solvers[k].name)];
+                sum.first += 1e9 * best / std::max(stats.m, 1);
+                sum.second++;
+            }
+
+            std::stringstream cell;
+            cell << best << "s " << value << (correct ? "" : " WRONG");
+            table[k][i] = cell.str();
+        }
+
+        if (compression) printCompression(instances[i].name, G, s, t, repetitions);
+    }
+
+    // print the table
+
+    std::cout.width(34);
+    std::cout<<std::left<<"solver";
+    for (size_t i = 0; i < instances.size(); i++){
+        std::cout.width(28);
+        std::cout<<instances[i].name;
+    }
+    std::cout<<std::endl;
+
+    for (size_t k = 0; k < solvers.size(); k++){
+        std::cout.width(34);
+        std::cout<<solvers[k].name;
+        for (size_t i = 0; i < instances.size(); i++){
+            std::cout.width(28);
+            std::cout<<table[k][i];
+        }
+        std::cout<<std::endl;
+    }
+
+    if (!calibrationPath.empty()){
+        std::vector<CalibrationEntry> calibration;
+        for (std::map<std::pair<std::string, std::string>, std::pair<double, int> >::iterator c = perClass.begin(); c != perClass.end(); c++){
+            CalibrationEntry entry = {c->first.first, c->first.second, c->second.first / c->second.second};
+            calibration.push_back(entry);
+        }
+
+        if (!writeCalibration(calibrationPath, calibration)){
+            std::cout<<"Could not write the calibration table "<<calibrationPath<<std::endl;
+            return 1;
+        }
+        std::cout<<std::endl<<"Calibration table written to "<<calibrationPath<<std::endl;
+    }
+
+    if (!allCorrect){
+        std::cout<<std::endl<<"Some flows were not maximum or did not match the flow value of "<<solvers[0].name<<std::endl;
+        return 1;
+    }
+
+    return 0;
+
+}
+
+long flowValue(Graph& G, Vertex s){
+
+    OutEdgeIterator out_e_it, out_e_it_end;
+    InEdgeIterator in_e_it, in_e_it_end;
+
+    long value = 0;
+
+    for (tie(out_e_it, out_e_it_end) = out_edges(s, G); out_e_it != out_e_it_end; out_e_it++){
+        value += G[*out_e_it].f;
+    }
+    for (tie(in_e_it, in_e_it_end) = in_edges(s, G); in_e_it != in_e_it_end; in_e_it++){
+        value -= G[*in_e_it].f;
+    }
+
+    return value;
+
+}
+
+void printCompression(const std::string& name, Graph& G, Vertex s, Vertex t, int repetitions){
+
+    EdgeIterator e_it, e_it_end;
+
+    double m = std::max((int)num_edges(G), 1);
+    float bestFlat = 0, bestCompressed = 0;
+    size_t flatBytes = 0, compressedBytes = 0, headBytes = 0;
+
+    for (int r = 0; r < repetitions; r++){
+        for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+            G[*e_it].f = 0;
+        }
+
+        FlatNetwork F;
+        buildFlatNetwork(G, F);
+        CompressedNetwork C;
+        buildCompressedNetwork(G, C);
+
+        flatBytes = flatNetworkBytes(F);
+        compressedBytes = compressedNetworkBytes(C);
+        headBytes = C.heads.size();
+
+        float T = 0;
+        threadTime(T);
+        cursorShortestAugmentedPath(F, s, t);
+        float flat_T = threadTime(T);
+        cursorShortestAugmentedPath(C, s, t);
+        float compressed_T = threadTime(T);
+
+        if (r == 0 || flat_T < bestFlat) bestFlat = flat_T;
+        if (r == 0 || compressed_T < bestCompressed) bestCompressed = compressed_T;
+    }
+
+    std::cout<<name<<": flat "<<flatBytes / m<<" bytes per edge, compressed "<<compressedBytes / m<<" ("<<headBytes / (2 * m)<<" per head), ";
+    std::cout<<"cursor solver "<<bestFlat<<"s flat, "<<bestCompressed<<"s compressed"<<std::endl;
+
+}
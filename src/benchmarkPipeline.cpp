@@ -0,0 +1,45 @@
+#include "benchmarkPipeline.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+int numberOfCores(){
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 1) return 1;
+    return (int)cores;
+}
+
+bool pinThreadToCore(int core){
+    if (core < 0 || core >= numberOfCores()) return false;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(core, &set);
+
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set) == 0;
+}
+
+bool pinThreadAwayFromCore(int core){
+    int cores = numberOfCores();
+    if (cores < 2) return false;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int c = 0; c < cores; c++){
+        if (c != core) CPU_SET(c, &set);
+    }
+
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set) == 0;
+}
+
+cpu_set_t threadAffinity(){
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &set);
+    return set;
+}
+
+bool restoreThreadAffinity(const cpu_set_t& set){
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set) == 0;
+}
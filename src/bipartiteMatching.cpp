@@ -0,0 +1,240 @@
+#include <iostream>
+#include "boostGraphStruct.hpp"
+#include "bipartiteMatching.hpp"
+#include "flatShortestAugmentedPath.hpp"
+#include <climits>
+
+using namespace boost;
+
+// layers the left vertices by alternating bfs from the free ones. returns the length of the
+// shortest augmenting path, or INT_MAX if there is none
+int matchingLayers(const BipartiteNetwork& B, const std::vector<int>& matchArc, const std::vector<int>& matchRight, std::vector<int>& dist);
+
+// augments along vertex disjoint shortest paths in the layers and returns how many were found
+int matchingAugment(const BipartiteNetwork& B, std::vector<int>& matchArc, std::vector<int>& matchRight, std::vector<int>& dist, int limit);
+
+
+bool bipartiteMaxFlow(Graph& G, const BipartiteNetwork& B){
+
+    EdgeIterator e_it, e_it_end;
+
+    // flow = 0
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+        G[*e_it].f = 0;
+    }
+
+    std::vector<int> matchArc;
+
+    if (hopcroftKarp(B, matchArc) == 0){
+        std::cout<<"t is not reachable from s"<<std::endl;
+        return false;
+    }
+
+    // every matched pair is one unit on s -> u -> v -> t
+    for (int u = 0; u < B.left; u++){
+        int a = matchArc[u];
+        if (a < 0) continue;
+        G[B.sourceEdge[u]].f = 1;
+        G[B.arcEdge[a]].f = 1;
+        G[B.sinkEdge[B.adj[a]]].f = 1;
+    }
+
+    return true;
+
+}
+
+bool bipartiteMaxFlow(Graph& G, Vertex s, Vertex t){
+
+    BipartiteNetwork B;
+
+    if (!buildBipartiteNetwork(G, s, t, B)){
+        return flatShortestAugmentedPath(G, s, t);
+    }
+
+    return bipartiteMaxFlow(G, B);
+
+}
+
+bool buildBipartiteNetwork(Graph& G, Vertex s, Vertex t, BipartiteNetwork& B){
+
+    OutEdgeIterator out_e_it, out_e_it_end;
+    InEdgeIterator in_e_it, in_e_it_end;
+    EdgeIterator e_it, e_it_end;
+
+    int n = num_vertices(G);
+
+    if (s == t || in_degree(s, G) > 0 || out_degree(t, G) > 0) return false;
+
+    // index of every vertex on its side, -1 if it is on neither
+    std::vector<int> leftIndex(n, -1);
+    std::vector<int> rightIndex(n, -1);
+
+    B.sourceEdge.clear();
+    B.sinkEdge.clear();
+
+    for (tie(out_e_it, out_e_it_end) = out_edges(s, G); out_e_it != out_e_it_end; out_e_it++){
+        Vertex u = target(*out_e_it, G);
+        // a second edge from s would let u carry two units
+        if (G[*out_e_it].cap != 1 || u == t || leftIndex[u] >= 0) return false;
+        leftIndex[u] = B.sourceEdge.size();
+        B.sourceEdge.push_back(*out_e_it);
+    }
+
+    for (tie(in_e_it, in_e_it_end) = in_edges(t, G); in_e_it != in_e_it_end; in_e_it++){
+        Vertex v = source(*in_e_it, G);
+        if (G[*in_e_it].cap != 1 || v == s || leftIndex[v] >= 0 || rightIndex[v] >= 0) return false;
+        rightIndex[v] = B.sinkEdge.size();
+        B.sinkEdge.push_back(*in_e_it);
+    }
+
+    B.left = B.sourceEdge.size();
+    B.right = B.sinkEdge.size();
+
+    // every other edge goes from left to right with capacity 1. counted first, then placed
+    B.first.assign(B.left + 1, 0);
+
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+        Vertex u = source(*e_it, G);
+        Vertex v = target(*e_it, G);
+        if (u == s || v == t) continue;
+        if (G[*e_it].cap != 1 || leftIndex[u] < 0 || rightIndex[v] < 0) return false;
+        B.first[leftIndex[u] + 1]++;
+    }
+
+    for (int u = 0; u < B.left; u++){
+        B.first[u + 1] += B.first[u];
+    }
+
+    B.adj.assign(B.first[B.left], 0);
+    B.arcEdge.resize(B.first[B.left]);
+
+    std::vector<int> next(B.first.begin(), B.first.end() - 1);
+
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+        Vertex u = source(*e_it, G);
+        Vertex v = target(*e_it, G);
+        if (u == s || v == t) continue;
+        int a = next[leftIndex[u]]++;
+        B.adj[a] = rightIndex[v];
+        B.arcEdge[a] = *e_it;
+    }
+
+    return true;
+
+}
+
+int hopcroftKarp(const BipartiteNetwork& B, std::vector<int>& matchArc){
+
+    matchArc.assign(B.left, -1);
+    std::vector<int> matchRight(B.right, -1);
+    std::vector<int> dist(B.left);
+
+    int size = 0;
+
+    // greedy start, most of a random matching is found here
+    for (int u = 0; u < B.left; u++){
+        for (int a = B.first[u]; a < B.first[u + 1]; a++){
+            if (matchRight[B.adj[a]] >= 0) continue;
+            matchRight[B.adj[a]] = u;
+            matchArc[u] = a;
+            size++;
+            break;
+        }
+    }
+
+    // every phase finds a maximal set of shortest augmenting paths, O(sqrt(n)) phases
+    while (true){
+        int limit = matchingLayers(B, matchArc, matchRight, dist);
+        if (limit == INT_MAX) break;
+        size += matchingAugment(B, matchArc, matchRight, dist, limit);
+    }
+
+    return size;
+
+}
+
+int matchingLayers(const BipartiteNetwork& B, const std::vector<int>& matchArc, const std::vector<int>& matchRight, std::vector<int>& dist){
+
+    std::vector<int> queue;
+    queue.reserve(B.left);
+
+    for (int u = 0; u < B.left; u++){
+        if (matchArc[u] < 0){
+            dist[u] = 0;
+            queue.push_back(u);
+        }
+        else dist[u] = INT_MAX;
+    }
+
+    int limit = INT_MAX;
+
+    for (size_t q = 0; q < queue.size(); q++){
+        int u = queue[q];
+
+        // the layers past the first free right vertex are not needed
+        if (dist[u] + 1 >= limit) break;
+
+        for (int a = B.first[u]; a < B.first[u + 1]; a++){
+            int w = matchRight[B.adj[a]];
+            if (w < 0){
+                limit = dist[u] + 1;
+            }
+            else if (dist[w] == INT_MAX){
+                dist[w] = dist[u] + 1;
+                queue.push_back(w);
+            }
+        }
+    }
+
+    return limit;
+
+}
+
+int matchingAugment(const BipartiteNetwork& B, std::vector<int>& matchArc, std::vector<int>& matchRight, std::vector<int>& dist, int limit){
+
+    // current arc of every left vertex, so that every arc is looked at once per phase
+    std::vector<int> current(B.first.begin(), B.first.end() - 1);
+    std::vector<int> stack;
+
+    int found = 0;
+
+    for (int r = 0; r < B.left; r++){
+        if (matchArc[r] >= 0 || dist[r] != 0) continue;
+
+        // iterative dfs, stack holds the left vertices of the path from r
+        stack.assign(1, r);
+
+        while (!stack.empty()){
+            int u = stack.back();
+
+            if (current[u] == B.first[u + 1]){
+                // dead end, u is not tried again in this phase
+                dist[u] = INT_MAX;
+                stack.pop_back();
+                if (!stack.empty()) current[stack.back()]++;
+                continue;
+            }
+
+            int a = current[u];
+            int w = matchRight[B.adj[a]];
+
+            if (w < 0 && dist[u] + 1 == limit){
+                // free right vertex, flip the path. the vertices on it are used up
+                for (size_t k = 0; k < stack.size(); k++){
+                    int x = stack[k];
+                    matchRight[B.adj[current[x]]] = x;
+                    matchArc[x] = current[x];
+                    dist[x] = INT_MAX;
+                }
+                found++;
+                break;
+            }
+
+            if (w >= 0 && dist[w] == dist[u] + 1) stack.push_back(w);
+            else current[u]++;
+        }
+    }
+
+    return found;
+
+}
@@ -0,0 +1,98 @@
+#include <iostream>
+#include "boostGraphStruct.hpp"
+#include "boostBaselines.hpp"
+#include <boost/graph/edmonds_karp_max_flow.hpp>
+#include <boost/graph/push_relabel_max_flow.hpp>
+#include <boost/graph/boykov_kolmogorov_max_flow.hpp>
+#include <vector>
+
+using namespace boost;
+
+typedef adjacency_list_traits<vecS, vecS, directedS> FlowTraits;
+
+// graph with the property maps the Boost max flow algorithms need. the vertex properties are
+// only used by boykov_kolmogorov_max_flow
+typedef adjacency_list<vecS, vecS, directedS,
+    property<vertex_color_t, default_color_type,
+        property<vertex_distance_t, long,
+            property<vertex_predecessor_t, FlowTraits::edge_descriptor> > >,
+    property<edge_capacity_t, long,
+        property<edge_residual_capacity_t, long,
+            property<edge_reverse_t, FlowTraits::edge_descriptor> > > > FlowGraph;
+
+typedef graph_traits<FlowGraph>::edge_descriptor FlowEdge;
+
+enum BoostMaxFlowAlgorithm
+{
+    BOOST_EDMONDS_KARP,
+    BOOST_PUSH_RELABEL,
+    BOOST_BOYKOV_KOLMOGOROV
+};
+
+// copies G into a FlowGraph, runs [algorithm] and writes the flow back to G
+bool runBoostMaxFlow(Graph& G, Vertex s, Vertex t, BoostMaxFlowAlgorithm algorithm);
+
+
+bool boostEdmondsKarp(Graph& G, Vertex s, Vertex t){
+    return runBoostMaxFlow(G, s, t, BOOST_EDMONDS_KARP);
+}
+
+bool boostPushRelabel(Graph& G, Vertex s, Vertex t){
+    return runBoostMaxFlow(G, s, t, BOOST_PUSH_RELABEL);
+}
+
+bool boostBoykovKolmogorov(Graph& G, Vertex s, Vertex t){
+    return runBoostMaxFlow(G, s, t, BOOST_BOYKOV_KOLMOGOROV);
+}
+
+bool runBoostMaxFlow(Graph& G, Vertex s, Vertex t, BoostMaxFlowAlgorithm algorithm){
+
+    EdgeIterator e_it, e_it_end;
+
+    FlowGraph F(num_vertices(G));
+
+    property_map<FlowGraph, edge_capacity_t>::type capacity = get(edge_capacity, F);
+    property_map<FlowGraph, edge_residual_capacity_t>::type residual = get(edge_residual_capacity, F);
+    property_map<FlowGraph, edge_reverse_t>::type reverse = get(edge_reverse, F);
+
+    // forward edge of every edge of G, in the order edges(G) visits them
+    std::vector<FlowEdge> forward;
+    forward.reserve(num_edges(G));
+
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+        Vertex u = source(*e_it, G);
+        Vertex w = target(*e_it, G);
+
+        FlowEdge a = add_edge(u, w, F).first;
+        FlowEdge b = add_edge(w, u, F).first;
+
+        capacity[a] = G[*e_it].cap;
+        capacity[b] = 0;
+        reverse[a] = b;
+        reverse[b] = a;
+
+        forward.push_back(a);
+    }
+
+    // the value is not needed, the flow is read back from the residuals. a zero flow is a valid
+    // max flow too, so the result is for the caller to check
+    switch (algorithm){
+        case BOOST_EDMONDS_KARP:
+            edmonds_karp_max_flow(F, s, t);
+            break;
+        case BOOST_PUSH_RELABEL:
+            push_relabel_max_flow(F, s, t);
+            break;
+        case BOOST_BOYKOV_KOLMOGOROV:
+            boykov_kolmogorov_max_flow(F, s, t);
+            break;
+    }
+
+    int k = 0;
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++, k++){
+        G[*e_it].f = capacity[forward[k]] - residual[forward[k]];
+    }
+
+    return true;
+
+}
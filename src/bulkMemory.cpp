@@ -0,0 +1,235 @@
+#include "bulkMemory.hpp"
+#include "benchmarkPipeline.hpp"
+#include <atomic>
+#include <thread>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <dirent.h>
+
+#ifndef MPOL_INTERLEAVE
+#define MPOL_INTERLEAVE 3
+#endif
+
+// in front of every block. 64 bytes so the array itself stays cache line aligned
+struct BulkHeader
+{
+    size_t mappedLength;        // 0 if the block came from malloc
+    void* base;
+    char padding[64 - sizeof(size_t) - sizeof(void*)];
+};
+
+const size_t HUGE_PAGE_BYTES = 2 << 20;
+
+BulkMemoryPolicy currentPolicy;
+
+std::atomic<long long> mappedBytes(0);
+std::atomic<long long> explicitHugeBytes(0);
+std::atomic<long long> interleavedBytes(0);
+std::atomic<long long> firstTouchBytes(0);
+std::atomic<long long> fallbacks(0);
+
+// maps [length] bytes with the huge pages of the policy, 2 MB aligned if huge pages are asked for.
+// [length] is a multiple of the page size. returns MAP_FAILED if nothing could be mapped
+void* mapBulk(size_t length, BulkHugePages hugePages);
+
+// spreads the pages of [length] bytes at [base] over the nodes with mbind
+void interleaveBulk(void* base, size_t length);
+
+// writes every [page] of [length] bytes at [base] from [threads] threads pinned to their own cores
+void firstTouchBulk(void* base, size_t length, size_t page, int threads);
+
+// counts the node directories in /sys
+int countNumaNodes();
+
+
+void setBulkMemoryPolicy(const BulkMemoryPolicy& policy){
+    currentPolicy = policy;
+}
+
+const BulkMemoryPolicy& bulkMemoryPolicy(){
+    return currentPolicy;
+}
+
+BulkMemoryStats bulkMemoryStats(){
+
+    BulkMemoryStats stats;
+    stats.mappedBytes = mappedBytes;
+    stats.explicitHugeBytes = explicitHugeBytes;
+    stats.interleavedBytes = interleavedBytes;
+    stats.firstTouchBytes = firstTouchBytes;
+    stats.fallbacks = fallbacks;
+
+    return stats;
+
+}
+
+int numaNodes(){
+    static int nodes = countNumaNodes();
+    return nodes;
+}
+
+int countNumaNodes(){
+
+    int count = 0;
+
+    DIR* dir = opendir("/sys/devices/system/node");
+    if (dir){
+        struct dirent* entry;
+        while ((entry = readdir(dir)) != NULL){
+            if (strncmp(entry->d_name, "node", 4) == 0 && entry->d_name[4] >= '0' && entry->d_name[4] <= '9') count++;
+        }
+        closedir(dir);
+    }
+
+    return count > 0 ? count : 1;
+
+}
+
+void* bulkAllocate(size_t bytes){
+
+    const BulkMemoryPolicy& policy = currentPolicy;
+
+    bool plain = policy.placement == PLACEMENT_DEFAULT && policy.hugePages == HUGE_PAGES_NONE;
+
+    if (plain || bytes < policy.minBytes){
+        // malloc only aligns to 16 bytes
+        void* block;
+        if (posix_memalign(&block, sizeof(BulkHeader), bytes + sizeof(BulkHeader)) != 0) throw std::bad_alloc();
+
+        BulkHeader* header = static_cast<BulkHeader*>(block);
+        header->mappedLength = 0;
+        header->base = block;
+
+        return header + 1;
+    }
+
+    size_t page = policy.hugePages != HUGE_PAGES_NONE ? HUGE_PAGE_BYTES : (size_t)sysconf(_SC_PAGESIZE);
+    size_t length = (bytes + sizeof(BulkHeader) + page - 1) / page * page;
+
+    void* base = mapBulk(length, policy.hugePages);
+    if (base == MAP_FAILED) throw std::bad_alloc();
+
+    mappedBytes += length;
+
+    if (policy.placement == PLACEMENT_INTERLEAVE) interleaveBulk(base, length);
+    if (policy.placement == PLACEMENT_FIRST_TOUCH) firstTouchBulk(base, length, page, policy.touchThreads);
+
+    BulkHeader* header = static_cast<BulkHeader*>(base);
+    header->mappedLength = length;
+    header->base = base;
+
+    return header + 1;
+
+}
+
+void bulkFree(void* p){
+
+    if (!p) return;
+
+    BulkHeader* header = static_cast<BulkHeader*>(p) - 1;
+
+    if (header->mappedLength == 0) free(header->base);
+    else munmap(header->base, header->mappedLength);
+
+}
+
+
+void* mapBulk(size_t length, BulkHugePages hugePages){
+
+    void* base = MAP_FAILED;
+
+    if (hugePages == HUGE_PAGES_EXPLICIT){
+        base = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (base != MAP_FAILED){
+            explicitHugeBytes += length;
+            return base;
+        }
+        // no reserved huge pages, ask for transparent ones instead
+        fallbacks++;
+    }
+
+    if (hugePages == HUGE_PAGES_NONE){
+        return mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+
+    // mmap only aligns to the base page size, and transparent huge pages only back 2 MB aligned
+    // ranges. map one huge page more and give back what lies before and after the aligned range
+    base = mmap(NULL, length + HUGE_PAGE_BYTES, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) return base;
+
+    uintptr_t start = reinterpret_cast<uintptr_t>(base);
+    uintptr_t aligned = (start + HUGE_PAGE_BYTES - 1) / HUGE_PAGE_BYTES * HUGE_PAGE_BYTES;
+
+    if (aligned > start) munmap(base, aligned - start);
+    if (start + HUGE_PAGE_BYTES > aligned) munmap(reinterpret_cast<void*>(aligned + length), start + HUGE_PAGE_BYTES - aligned);
+
+    base = reinterpret_cast<void*>(aligned);
+
+    if (madvise(base, length, MADV_HUGEPAGE) != 0) fallbacks++;
+
+    return base;
+
+}
+
+void interleaveBulk(void* base, size_t length){
+
+    int nodes = numaNodes();
+
+    // nothing to spread over on a single node machine
+    if (nodes < 2) return;
+
+    const int BITS = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> mask((nodes + BITS - 1) / BITS, 0);
+    for (int node = 0; node < nodes; node++){
+        mask[node / BITS] |= 1UL << (node % BITS);
+    }
+
+    // the mbind system call directly, so that libnuma is not needed
+    if (syscall(SYS_mbind, base, length, MPOL_INTERLEAVE, mask.data(), mask.size() * BITS + 1, 0) == 0){
+        interleavedBytes += length;
+    }
+    else{
+        fallbacks++;
+    }
+
+}
+
+void firstTouchBulk(void* base, size_t length, size_t page, int threads){
+
+    int cores = numberOfCores();
+    if (threads <= 0 || threads > cores) threads = cores;
+
+    // a huge page is placed as a whole, so the chunks are split on the page size of the mapping
+    size_t pages = length / page;
+
+    if (threads > (int)pages) threads = pages;
+
+    std::vector<std::thread> touchers;
+
+    for (int k = 0; k < threads; k++){
+        size_t begin = pages * k / threads * page;
+        size_t end = pages * (k + 1) / threads * page;
+        int core = (long long)k * cores / threads;
+
+        touchers.push_back(std::thread([=]{
+            // not pinned on machines that do not allow it, which only affects the placement
+            pinThreadToCore(core);
+            char* bytes = static_cast<char*>(base);
+            for (size_t b = begin; b < end; b += page){
+                bytes[b] = 0;
+            }
+        }));
+    }
+
+    for (size_t k = 0; k < touchers.size(); k++){
+        touchers[k].join();
+    }
+
+    firstTouchBytes += length;
+
+}
@@ -1,6 +1,8 @@
 #include "boostGraphStruct.hpp"
 #include "checkMaxFlow.hpp"
 #include "visitor_graph.hpp"
+#include "traceSpans.hpp"
+#include "solverWorkspace.hpp"
 #include <queue>
 #include <vector>
 // #include <boost/graph/depth_first_search.hpp>
@@ -8,6 +10,12 @@
 using namespace boost;
 
 bool CHECK_MAX_FLOW_T(Graph& G, Vertex s, Vertex t, bool printErrorName){
+	return CHECK_MAX_FLOW_T(G, s, t, printErrorName, threadWorkspace());
+}
+
+bool CHECK_MAX_FLOW_T(Graph& G, Vertex s, Vertex t, bool printErrorName, SolverWorkspace& ws){
+
+	TRACE_SPAN("CHECK_MAX_FLOW_T");
 	
 	// Vertex v;
 	// Edge e;
@@ -33,21 +41,21 @@ bool CHECK_MAX_FLOW_T(Graph& G, Vertex s, Vertex t, bool printErrorName){
 		}
 	}
 
-	// calculate excess for all nodes/vertexes
-
-	std::vector<long> excess(n, 0);
-
-	for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
-		Vertex v = source(*e_it, G);
-		Vertex w = target(*e_it, G);
-		excess[v] -= G[*e_it].f;
-		excess[w] += G[*e_it].f;
-	}
-
-	// node with non-zero excess error
+	// node with non-zero excess error. the excess of a node is summed over its own edges, so
+	// there is no excess array to allocate
 	
 	for (tie(v_it, v_it_end) = vertices(G); v_it != v_it_end; v_it++){
-		if (!(*v_it == s || *v_it == t || excess[*v_it] == 0)){
+		if (*v_it == s || *v_it == t) continue;
+
+		long excess = 0;
+		for (tie(in_e_it, in_e_it_end) = in_edges(*v_it, G); in_e_it != in_e_it_end; in_e_it++){
+			excess += G[*in_e_it].f;
+		}
+		for (tie(out_e_it, out_e_it_end) = out_edges(*v_it, G); out_e_it != out_e_it_end; out_e_it++){
+			excess -= G[*out_e_it].f;
+		}
+
+		if (excess != 0){
 			if (printErrorName){
 				std::cout<< "Node with non-zero excess"<<std::endl;
 				std::cout<< "Node: "<<G[*v_it].name<<std::endl;
@@ -57,36 +65,38 @@ bool CHECK_MAX_FLOW_T(Graph& G, Vertex s, Vertex t, bool printErrorName){
 		}
 	}
 
-	// Compute nodes reachable from s using BFS
+	// Compute nodes reachable from s using BFS. reached is the mark of the workspace
+
+	ws.reserve(n, num_edges(G));
+	ws.newEpoch();
 
-	std::vector<bool> reached(n, false);
-	std::queue<Vertex> Q;
+	std::vector<Vertex>& Q = ws.queue;
+	Q.clear();
 
-	Q.push(s);
-	reached[s] = true;
+	Q.push_back(s);
+	ws.mark(s);
 
-	while (!Q.empty()){
+	for (size_t q = 0; q < Q.size(); q++){
 
-		Vertex v = Q.front();
-		Q.pop();
+		Vertex v = Q[q];
 		// for all out edges
 		for (tie(out_e_it, out_e_it_end) = out_edges(v, G); out_e_it != out_e_it_end; out_e_it++){
 			Vertex w = target(*out_e_it, G);
-			if (G[*out_e_it].f < G[*out_e_it].cap && !reached[w]){
-				reached[w] = true;
-				Q.push(w);
+			if (G[*out_e_it].f < G[*out_e_it].cap && !ws.marked(w)){
+				ws.mark(w);
+				Q.push_back(w);
 			}
 		}
 		// for all in edges
 		for (tie(in_e_it, in_e_it_end) = in_edges(v, G); in_e_it != in_e_it_end; in_e_it++){
 			Vertex w = source(*in_e_it, G);
-			if (G[*in_e_it].f > 0 && !reached[w]){
-				reached[w] = true;
-				Q.push(w);
+			if (G[*in_e_it].f > 0 && !ws.marked(w)){
+				ws.mark(w);
+				Q.push_back(w);
 			}
 		}
 	}
-	if (reached[t]){
+	if (ws.marked(t)){
 		if (printErrorName){
 			std::cout<<"t is reachable in G_f"<<std::endl;
 		}
@@ -0,0 +1,276 @@
+#include <iostream>
+#include "boostGraphStruct.hpp"
+#include "compressedNetwork.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+
+using namespace boost;
+
+// appends [value] to [bytes] as a varint
+void encodeVarint(BulkVector<unsigned char>& bytes, unsigned int value);
+
+// exact distance labels to t, like flatExactLabels but through the cursors
+template <typename Network, typename Cursor>
+void cursorExactLabels(const Network& N, int t, BulkVector<int>& d);
+
+template <typename Network, typename Cursor>
+bool cursorSolve(Network& N, int s, int t);
+
+
+bool compressedShortestAugmentedPath(Graph& G, Vertex s, Vertex t){
+
+    EdgeIterator e_it, e_it_end;
+
+    // flow = 0
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+        G[*e_it].f = 0;
+    }
+
+    CompressedNetwork N;
+    buildCompressedNetwork(G, N);
+
+    if (!cursorShortestAugmentedPath(N, s, t)){
+        std::cout<<"t is not reachable from s"<<std::endl;
+        return false;
+    }
+
+    writeCompressedFlow(G, N);
+
+    return true;
+
+}
+
+void buildCompressedNetwork(Graph& G, CompressedNetwork& N){
+
+    EdgeIterator e_it, e_it_end;
+
+    int n = num_vertices(G);
+    int m = num_edges(G);
+
+    N.n = n;
+    N.m = m;
+
+    N.first.assign(n + 1, 0);
+
+    // edges are numbered in the order edges(G) visits them, which is the order they were added in
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+        N.first[source(*e_it, G) + 1]++;
+        N.first[target(*e_it, G) + 1]++;
+    }
+    for (int v = 0; v < n; v++){
+        N.first[v + 1] += N.first[v];
+    }
+
+    // (head, 2k) for the forward arc of edge k and (head, 2k + 1) for its reverse arc, sorted by
+    // head within every vertex. the residuals are kept by 2k and 2k + 1 until the arcs are placed
+    std::vector<uint64_t> arcs(2 * m);
+    std::vector<int> residual(2 * m);
+    std::vector<int> next(N.first.begin(), N.first.end() - 1);
+
+    int k = 0;
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++, k++){
+        int v = source(*e_it, G);
+        int w = target(*e_it, G);
+        arcs[next[v]++] = ((uint64_t)w << 32) | (uint32_t)(2 * k);
+        arcs[next[w]++] = ((uint64_t)v << 32) | (uint32_t)(2 * k + 1);
+        residual[2 * k] = G[*e_it].cap - G[*e_it].f;
+        residual[2 * k + 1] = G[*e_it].f;
+    }
+
+    std::vector<int>().swap(next);
+
+    N.offset.assign(n + 1, 0);
+    N.heads.clear();
+    N.heads.reserve(2 * m);
+
+    // position of every arc, by 2k and 2k + 1
+    std::vector<int> position(2 * m);
+
+    for (int v = 0; v < n; v++){
+        std::sort(arcs.begin() + N.first[v], arcs.begin() + N.first[v + 1]);
+
+        int previous = v;
+        for (int a = N.first[v]; a < N.first[v + 1]; a++){
+            int head = arcs[a] >> 32;
+            if (a == N.first[v]){
+                int difference = head - v;
+                encodeVarint(N.heads, ((unsigned int)difference << 1) ^ (unsigned int)(difference >> 31));
+            }
+            else encodeVarint(N.heads, head - previous);
+            previous = head;
+            position[(uint32_t)arcs[a]] = a;
+        }
+
+        N.offset[v + 1] = N.heads.size();
+    }
+
+    std::vector<uint64_t>().swap(arcs);
+    N.heads.shrink_to_fit();
+
+    N.residual.assign(2 * m, 0);
+    N.mate.assign(2 * m, 0);
+    N.forwardArc.assign(m, 0);
+
+    for (int key = 0; key < 2 * m; key++){
+        N.residual[position[key]] = residual[key];
+        N.mate[position[key]] = position[key ^ 1];
+    }
+    for (int e = 0; e < m; e++){
+        N.forwardArc[e] = position[2 * e];
+    }
+
+}
+
+void writeCompressedFlow(Graph& G, const CompressedNetwork& N){
+
+    EdgeIterator e_it, e_it_end;
+
+    int k = 0;
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++, k++){
+        G[*e_it].f = N.residual[N.mate[N.forwardArc[k]]];
+    }
+
+}
+
+size_t compressedNetworkBytes(const CompressedNetwork& N){
+    return N.offset.capacity() * sizeof(long long) + N.first.capacity() * sizeof(int) + N.heads.capacity()
+        + (N.residual.capacity() + N.mate.capacity() + N.forwardArc.capacity()) * sizeof(int);
+}
+
+size_t flatNetworkBytes(const FlatNetwork& N){
+    return (N.first.capacity() + N.head.capacity() + N.residual.capacity() + N.mate.capacity() + N.forwardArc.capacity()) * sizeof(int)
+        + N.edges.capacity() * sizeof(Edge);
+}
+
+bool cursorShortestAugmentedPath(CompressedNetwork& N, int s, int t){
+    return cursorSolve<CompressedNetwork, CompressedArcCursor>(N, s, t);
+}
+
+bool cursorShortestAugmentedPath(FlatNetwork& N, int s, int t){
+    return cursorSolve<FlatNetwork, FlatArcCursor>(N, s, t);
+}
+
+template <typename Network, typename Cursor>
+bool cursorSolve(Network& N, int s, int t){
+
+    int n = N.n;
+
+    BulkVector<int> d;
+    cursorExactLabels<Network, Cursor>(N, t, d);
+
+    if (d[s] >= n) return false;
+
+    // number of vertices with each label, for the gap test
+    BulkVector<int> count(n + 1, 0);
+    for (int v = 0; v < n; v++){
+        count[d[v]]++;
+    }
+
+    // the current arc of a vertex is a cursor, a compressed arc list can only be walked forward
+    std::vector<Cursor> current(n);
+    for (int v = 0; v < n; v++){
+        current[v] = Cursor(N, v);
+    }
+
+    // arc and vertex the vertex was reached with. the tail of an arc is not stored in either format
+    BulkVector<int> predArc(n, -1);
+    BulkVector<int> predVertex(n, -1);
+
+    int* residual = N.residual.data();
+    const int* mate = N.mate.data();
+
+    int i = s;
+
+    while (d[s] < n){
+
+        // advance
+
+        Cursor& c = current[i];
+        int target = d[i] - 1;
+
+        while (c.valid() && (residual[c.arc] <= 0 || d[c.head] != target)) c.next();
+
+        if (c.valid()){
+
+            int j = c.head;
+            predArc[j] = c.arc;
+            predVertex[j] = i;
+            i = j;
+
+            if (i == t){
+                int delta = INT_MAX;
+                for (int v = t; v != s; v = predVertex[v]){
+                    delta = std::min(delta, residual[predArc[v]]);
+                }
+                for (int v = t; v != s; v = predVertex[v]){
+                    residual[predArc[v]] -= delta;
+                    residual[mate[predArc[v]]] += delta;
+                }
+                i = s;
+            }
+
+            continue;
+        }
+
+        // retreat
+
+        int mind = n;
+        for (Cursor r(N, i); r.valid(); r.next()){
+            if (residual[r.arc] > 0 && d[r.head] < mind) mind = d[r.head];
+        }
+        int newD = mind >= n ? n : mind + 1;
+
+        count[d[i]]--;
+
+        // no vertex is left with the old label of i, so s is cut off from t
+        if (count[d[i]] == 0) break;
+
+        d[i] = newD;
+        count[newD]++;
+        current[i] = Cursor(N, i);
+
+        if (i != s){
+            i = predVertex[i];
+        }
+
+    }
+
+    return true;
+
+}
+
+template <typename Network, typename Cursor>
+void cursorExactLabels(const Network& N, int t, BulkVector<int>& d){
+
+    int n = N.n;
+
+    d.assign(n, n);
+    d[t] = 0;
+
+    // v gets a label from w if the residual arc v->w exists, which is the mate of an arc of w
+    BulkVector<int> queue;
+    queue.reserve(n);
+    queue.push_back(t);
+
+    for (size_t q = 0; q < queue.size(); q++){
+        int w = queue[q];
+        for (Cursor c(N, w); c.valid(); c.next()){
+            int v = c.head;
+            if (d[v] != n || N.residual[N.mate[c.arc]] <= 0) continue;
+            d[v] = d[w] + 1;
+            queue.push_back(v);
+        }
+    }
+
+}
+
+void encodeVarint(BulkVector<unsigned char>& bytes, unsigned int value){
+
+    while (value >= 0x80){
+        bytes.push_back((unsigned char)(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back((unsigned char)value);
+
+}
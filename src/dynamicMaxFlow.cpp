@@ -0,0 +1,323 @@
+#include <iostream>
+#include "boostGraphStruct.hpp"
+#include "dynamicMaxFlow.hpp"
+#include "flatShortestAugmentedPath.hpp"
+#include <climits>
+
+using namespace boost;
+
+
+DynamicMaxFlow::DynamicMaxFlow(Graph& G, Vertex s, Vertex t) : G(G), s(s), t(t), inserted(false){
+
+    stats.cancelledFlow = 0;
+    stats.cancelPaths = 0;
+    stats.rebuilt = false;
+
+    rebuild();
+
+}
+
+void DynamicMaxFlow::setCapacity(Edge e, int cap){
+
+    if (deletedEdges.count(&G[e])) return;
+
+    std::unordered_map<const myEdge*, int>::iterator k = edgeNumber.find(&G[e]);
+
+    // an edge inserted since the last solve is not in N yet and gets its capacity from G
+    if (k == edgeNumber.end()) G[e].cap = cap;
+    else capacityChanges.push_back(std::make_pair(k->second, cap));
+
+}
+
+Edge DynamicMaxFlow::insertEdge(Vertex u, Vertex w, int cap){
+
+    // zero flow on a new edge is always feasible, it only has to be in N before the next solve
+    Edge e = add_edge(u, w, G).first;
+    G[e].cap = cap;
+    G[e].f = 0;
+    inserted = true;
+
+    return e;
+
+}
+
+void DynamicMaxFlow::deleteEdge(Edge e){
+
+    std::unordered_map<const myEdge*, int>::iterator k = edgeNumber.find(&G[e]);
+
+    if (k == edgeNumber.end()){
+        remove_edge(e, G);
+        return;
+    }
+
+    // queued once, a second remove_edge of the same edge would fail in solve
+    if (!deletedEdges.insert(&G[e]).second) return;
+
+    // the edge keeps its arcs until the flow is repaired, with no capacity left
+    capacityChanges.push_back(std::make_pair(k->second, 0));
+    deleted.push_back(e);
+
+}
+
+bool DynamicMaxFlow::solve(){
+
+    stats.cancelledFlow = 0;
+    stats.cancelPaths = 0;
+    stats.rebuilt = false;
+
+    // new capacities. a lower capacity than the flow leaves an imbalance at both ends of the edge
+
+    for (size_t c = 0; c < capacityChanges.size(); c++){
+        int k = capacityChanges[c].first;
+        int a = N.forwardArc[k];
+        int b = N.mate[a];
+
+        N.residual[a] += capacityChanges[c].second - arcCap[a];
+        arcCap[a] = capacityChanges[c].second;
+        G[N.edges[k]].cap = capacityChanges[c].second;
+
+        clampArc(a);
+        clampArc(b);
+    }
+    capacityChanges.clear();
+
+    repair();
+
+    if (inserted || !deleted.empty()){
+        writeFlatFlow(G, N);
+
+        for (size_t d = 0; d < deleted.size(); d++){
+            remove_edge(deleted[d], G);
+        }
+        deleted.clear();
+        deletedEdges.clear();
+        inserted = false;
+
+        rebuild();
+        stats.rebuilt = true;
+    }
+
+    // false here only means that the flow already was maximum
+    flatShortestAugmentedPath(N, s, t);
+
+    writeFlatFlow(G, N);
+
+    return flowValue() > 0 || reachable();
+
+}
+
+long long DynamicMaxFlow::flowValue() const{
+    return flatFlowValue(N, s);
+}
+
+
+void DynamicMaxFlow::rebuild(){
+
+    buildFlatNetwork(G, N);
+
+    int n = N.n;
+
+    arcCap.assign(2 * N.m, 0);
+    edgeNumber.clear();
+
+    searchPred.assign(n, -1);
+    searchQueue.clear();
+
+    for (int k = 0; k < N.m; k++){
+        arcCap[N.forwardArc[k]] = G[N.edges[k]].cap;
+        edgeNumber[&G[N.edges[k]]] = k;
+    }
+
+    // the flow in G may not be feasible: arcs over capacity and vertices out of balance
+
+    excess.assign(n, 0);
+
+    for (int v = 0; v < n; v++){
+        for (int a = N.first[v]; a < N.first[v + 1]; a++){
+            excess[v] -= arcCap[a] - N.residual[a];
+        }
+    }
+
+    for (int a = 0; a < 2 * N.m; a++){
+        clampArc(a);
+    }
+
+    repair();
+
+}
+
+bool DynamicMaxFlow::reachable() const{
+
+    std::vector<bool> visited(N.n, false);
+    std::vector<int> queue(1, s);
+    visited[s] = true;
+
+    for (size_t q = 0; q < queue.size(); q++){
+        int y = queue[q];
+        if (y == t) return true;
+        for (int a = N.first[y]; a < N.first[y + 1]; a++){
+            int x = N.head[a];
+            if (visited[x] || arcCap[a] <= 0) continue;
+            visited[x] = true;
+            queue.push_back(x);
+        }
+    }
+
+    return false;
+
+}
+
+void DynamicMaxFlow::clampArc(int a){
+
+    if (N.residual[a] >= 0) return;
+
+    // sends the excess flow of a back, which moves it from the head of a to the tail
+    int over = -N.residual[a];
+    N.residual[a] += over;
+    N.residual[N.mate[a]] -= over;
+
+    excess[flatArcTail(N, a)] += over;
+    excess[N.head[a]] -= over;
+
+    stats.cancelledFlow += over;
+
+}
+
+void DynamicMaxFlow::repair(){
+
+    int n = N.n;
+
+    // the flow into a vertex with excess comes from s or from a vertex with a deficit, so a
+    // path of flow carrying arcs back to one of them always exists. excess is cancelled first
+    // because cancelling it may also cancel deficits on the way. s may only have a deficit and
+    // t only an excess, anything else is flow from t to s that has to go too
+
+    for (int v = 0; v < n; v++){
+        if (v == t) continue;
+        while (excess[v] > 0 && cancelExcess(v));
+    }
+
+    for (int v = 0; v < n; v++){
+        if (v == s) continue;
+        while (excess[v] < 0 && cancelDeficit(v));
+    }
+
+}
+
+bool DynamicMaxFlow::cancelExcess(int v){
+
+    // bfs against the flow. arc a of y carries flow into y if arcCap[a] - residual[a] < 0
+    std::vector<int>& pred = searchPred;    // arc of the vertex pointing to the one it was reached from
+    std::vector<int>& queue = searchQueue;
+    queue.assign(1, v);
+    pred[v] = INT_MAX;
+
+    int found = -1;
+
+    for (size_t q = 0; q < queue.size() && found < 0; q++){
+        int y = queue[q];
+        for (int a = N.first[y]; a < N.first[y + 1]; a++){
+            int x = N.head[a];
+            if (pred[x] != -1 || arcCap[a] - N.residual[a] >= 0) continue;
+            pred[x] = N.mate[a];
+            if ((x == s && v != s) || (x != s && excess[x] < 0)){
+                found = x;
+                break;
+            }
+            queue.push_back(x);
+        }
+    }
+
+    if (found < 0){
+        clearSearch(-1);
+        return false;
+    }
+
+    long long delta = excess[v];
+    if (found != s && -excess[found] < delta) delta = -excess[found];
+
+    for (int x = found; x != v; x = N.head[pred[x]]){
+        long long flow = arcCap[pred[x]] - N.residual[pred[x]];
+        if (flow < delta) delta = flow;
+    }
+
+    for (int x = found; x != v; x = N.head[pred[x]]){
+        N.residual[pred[x]] += delta;
+        N.residual[N.mate[pred[x]]] -= delta;
+    }
+
+    clearSearch(found);
+
+    excess[v] -= delta;
+    excess[found] += delta;
+
+    stats.cancelledFlow += delta;
+    stats.cancelPaths++;
+
+    return true;
+
+}
+
+bool DynamicMaxFlow::cancelDeficit(int v){
+
+    // bfs along the flow. arc a carries flow out of its tail if arcCap[a] - residual[a] > 0
+    std::vector<int>& pred = searchPred;    // arc the vertex was reached with
+    std::vector<int>& queue = searchQueue;
+    queue.assign(1, v);
+    pred[v] = INT_MAX;
+
+    int found = -1;
+
+    for (size_t q = 0; q < queue.size() && found < 0; q++){
+        int y = queue[q];
+        for (int a = N.first[y]; a < N.first[y + 1]; a++){
+            int x = N.head[a];
+            if (pred[x] != -1 || arcCap[a] - N.residual[a] <= 0) continue;
+            pred[x] = a;
+            if ((x == t && v != t) || (x != t && excess[x] > 0)){
+                found = x;
+                break;
+            }
+            queue.push_back(x);
+        }
+    }
+
+    if (found < 0){
+        clearSearch(-1);
+        return false;
+    }
+
+    long long delta = -excess[v];
+    if (found != t && excess[found] < delta) delta = excess[found];
+
+    for (int x = found; x != v; x = flatArcTail(N, pred[x])){
+        long long flow = arcCap[pred[x]] - N.residual[pred[x]];
+        if (flow < delta) delta = flow;
+    }
+
+    for (int x = found; x != v; x = flatArcTail(N, pred[x])){
+        N.residual[pred[x]] += delta;
+        N.residual[N.mate[pred[x]]] -= delta;
+    }
+
+    clearSearch(found);
+
+    excess[v] += delta;
+    excess[found] -= delta;
+
+    stats.cancelledFlow += delta;
+    stats.cancelPaths++;
+
+    return true;
+
+}
+
+void DynamicMaxFlow::clearSearch(int found){
+
+    // every vertex the search reached is in the queue, except the one it stopped at
+    for (size_t q = 0; q < searchQueue.size(); q++){
+        searchPred[searchQueue[q]] = -1;
+    }
+    if (found >= 0) searchPred[found] = -1;
+
+}
@@ -0,0 +1,273 @@
+#include <iostream>
+#include "boostGraphStruct.hpp"
+#include "edgeFailure.hpp"
+#include "flatShortestAugmentedPath.hpp"
+#include "benchmarkPipeline.hpp"
+#include <unordered_map>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <algorithm>
+
+using namespace boost;
+
+// sends up to [limit] from [from] to [to] along shortest residual paths of the fork and returns
+// the amount sent
+long long forkSend(FlowFork& F, int from, int to, long long limit, SolverWorkspace& ws);
+
+
+FlowFork::FlowFork(const FlatNetwork& base) : N(base), r(base.residual), stamp(base.residual.size(), 0), epoch(1) {}
+
+void FlowFork::push(int a, int delta){
+
+    int b = N.mate[a];
+
+    save(a);
+    save(b);
+    r[a] -= delta;
+    r[b] += delta;
+
+}
+
+void FlowFork::set(int a, int value){
+
+    save(a);
+    r[a] = value;
+
+}
+
+void FlowFork::discard(){
+
+    for (size_t k = 0; k < saved.size(); k++){
+        r[saved[k].first] = saved[k].second;
+    }
+    saved.clear();
+
+    if (++epoch == 0){
+        std::fill(stamp.begin(), stamp.end(), 0);
+        epoch = 1;
+    }
+
+}
+
+void FlowFork::save(int a){
+
+    if (stamp[a] == epoch) return;
+
+    stamp[a] = epoch;
+    saved.push_back(std::make_pair(a, r[a]));
+
+}
+
+bool edgeFailureSensitivity(Graph& G, Vertex s, Vertex t, const std::vector<Edge>& candidates, int threads, std::vector<EdgeFailure>& results, FailureAnalysisStats& stats){
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    EdgeIterator e_it, e_it_end;
+
+    // flow = 0
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+        G[*e_it].f = 0;
+    }
+
+    FlatNetwork N;
+    buildFlatNetwork(G, N);
+
+    if (!flatShortestAugmentedPath(N, s, t)){
+        std::cout<<"t is not reachable from s"<<std::endl;
+        return false;
+    }
+
+    writeFlatFlow(G, N);
+
+    int n = N.n;
+    long long baseFlow = flatFlowValue(N, s);
+
+    // s side of the min cut: the vertices s still reaches in the residual network
+    std::vector<char> sourceSide(n, 0);
+    std::vector<int> queue(1, s);
+    sourceSide[s] = 1;
+
+    for (size_t q = 0; q < queue.size(); q++){
+        int v = queue[q];
+        for (int a = N.first[v]; a < N.first[v + 1]; a++){
+            int w = N.head[a];
+            if (sourceSide[w] || N.residual[a] <= 0) continue;
+            sourceSide[w] = 1;
+            queue.push_back(w);
+        }
+    }
+
+    std::unordered_map<const myEdge*, int> edgeNumber;
+    for (int k = 0; k < N.m; k++){
+        edgeNumber[&G[N.edges[k]]] = k;
+    }
+
+    stats.baseFlow = baseFlow;
+    stats.noFlow = 0;
+    stats.onCut = 0;
+    stats.resolved = 0;
+
+    results.assign(candidates.size(), EdgeFailure());
+
+    // the edges that have to be solved again, as (index into candidates, edge number)
+    std::vector<std::pair<int, int> > forks;
+
+    for (size_t c = 0; c < candidates.size(); c++){
+        int k = edgeNumber[&G[candidates[c]]];
+        int a = N.forwardArc[k];
+
+        results[c].e = candidates[c];
+
+        if (flatEdgeFlow(N, k) == 0){
+            results[c].flow = baseFlow;
+            results[c].outcome = FAILURE_NO_FLOW;
+            stats.noFlow++;
+        }
+        else if (sourceSide[flatArcTail(N, a)] && !sourceSide[N.head[a]]){
+            // the cut loses the capacity of the edge, and giving back the flow of the saturated
+            // edge reaches that value
+            results[c].flow = baseFlow - flatEdgeCap(N, k);
+            results[c].outcome = FAILURE_ON_CUT;
+            stats.onCut++;
+        }
+        else{
+            results[c].outcome = FAILURE_RESOLVED;
+            forks.push_back(std::make_pair(c, k));
+            stats.resolved++;
+        }
+    }
+
+    if (threads <= 0) threads = numberOfCores();
+    threads = std::max(1, std::min(threads, (int)forks.size()));
+
+    std::atomic<int> nextFork(0);
+    std::atomic<long long> touchedArcs(0);
+
+    auto worker = [&](){
+        SolverWorkspace& ws = threadWorkspace();
+        FlowFork F(N);
+        long long touched = 0;
+
+        for (int i = nextFork++; i < (int)forks.size(); i = nextFork++){
+            results[forks[i].first].flow = forkedFailureFlow(F, s, t, forks[i].second, baseFlow, ws);
+            touched += F.touched();
+            F.discard();
+        }
+
+        touchedArcs += touched;
+    };
+
+    // the calling thread is worker 0
+    std::vector<std::thread> workers;
+    for (int k = 1; k < threads; k++){
+        workers.push_back(std::thread(worker));
+    }
+
+    worker();
+
+    for (size_t k = 0; k < workers.size(); k++){
+        workers[k].join();
+    }
+
+    stats.threads = threads;
+    stats.touchedArcs = touchedArcs;
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    return true;
+
+}
+
+long long forkedFailureFlow(FlowFork& F, int s, int t, int k, long long baseFlow, SolverWorkspace& ws){
+
+    const FlatNetwork& N = F.network();
+
+    int a = N.forwardArc[k];
+    int b = N.mate[a];
+    int u = flatArcTail(N, a);
+    int w = N.head[a];
+    int f = F.residual(b);
+
+    // the edge is gone: its flow stays at u, w is short of it, and neither arc can be used
+    F.set(a, 0);
+    F.set(b, 0);
+
+    long long value = baseFlow;
+    if (u == s) value -= f;
+    if (w == s) value += f;
+
+    // sending along a path changes the flow value only if the path starts or ends at s
+    long long sent;
+    long long left = f;
+
+    // other paths from u to w keep the flow as it is
+    sent = forkSend(F, u, w, left, ws);
+    left -= sent;
+    if (u == s) value += sent;
+    if (w == s) value -= sent;
+
+    // the rest goes back the way it came: from u to s, and from t to w. s and t may keep an
+    // imbalance, any other vertex has a path to one of them for all of its own
+    if (left > 0){
+        long long excess = u == s || u == t ? 0 : left;
+        long long deficit = w == s || w == t ? 0 : left;
+
+        sent = forkSend(F, u, s, excess, ws);
+        value -= sent;
+        forkSend(F, u, t, excess - sent, ws);
+
+        sent = forkSend(F, t, w, deficit, ws);
+        value += forkSend(F, s, w, deficit - sent, ws);
+    }
+
+    return value + forkSend(F, s, t, LLONG_MAX, ws);
+
+}
+
+long long forkSend(FlowFork& F, int from, int to, long long limit, SolverWorkspace& ws){
+
+    const FlatNetwork& N = F.network();
+
+    if (limit <= 0 || from == to) return 0;
+
+    ws.reserve(N.n, N.m);
+    if ((int)ws.arcPred.size() < N.n) ws.arcPred.resize(N.n);
+
+    long long sent = 0;
+
+    while (sent < limit){
+
+        // bfs from [from] over residual arcs, stopping at [to]
+        ws.newEpoch();
+        ws.queue.clear();
+        ws.queue.push_back(from);
+        ws.mark(from);
+
+        for (size_t q = 0; q < ws.queue.size() && !ws.marked(to); q++){
+            int v = ws.queue[q];
+            for (int a = N.first[v]; a < N.first[v + 1]; a++){
+                int x = N.head[a];
+                if (ws.marked(x) || F.residual(a) <= 0) continue;
+                ws.mark(x);
+                ws.arcPred[x] = a;
+                ws.queue.push_back(x);
+            }
+        }
+
+        if (!ws.marked(to)) break;
+
+        long long delta = limit - sent;
+        for (int v = to; v != from; v = flatArcTail(N, ws.arcPred[v])){
+            delta = std::min(delta, (long long)F.residual(ws.arcPred[v]));
+        }
+        for (int v = to; v != from; v = flatArcTail(N, ws.arcPred[v])){
+            F.push(ws.arcPred[v], delta);
+        }
+
+        sent += delta;
+    }
+
+    return sent;
+
+}
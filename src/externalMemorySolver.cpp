@@ -0,0 +1,466 @@
+#include <iostream>
+#include "boostGraphStruct.hpp"
+#include "externalMemorySolver.hpp"
+#include <climits>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace boost;
+
+static ExternalMemoryOptions externalMemoryOptions;
+
+// reads or writes [bytes] at [offset], retrying short transfers. returns false on an io error
+bool fullPread(int fd, void* buffer, size_t bytes, off_t offset);
+bool fullPwrite(int fd, const void* buffer, size_t bytes, off_t offset);
+
+
+ExternalArcStore::ExternalArcStore() : blockReads(0), blockWrites(0), batchedUpdates(0), fd(-1), arcs(0), blocks(0), blockArcs(0), readAhead(0), maxPendingUpdates(0), clockHand(0), pendingUpdates(0) {}
+
+ExternalArcStore::~ExternalArcStore(){
+    close();
+}
+
+bool ExternalArcStore::open(long long arcs, const ExternalMemoryOptions& options){
+
+    close();
+
+    std::string path = options.directory + "/adst-arcs-XXXXXX";
+    std::vector<char> name(path.begin(), path.end());
+    name.push_back('\0');
+
+    fd = mkstemp(&name[0]);
+    if (fd < 0) return false;
+
+    // the file disappears with the last descriptor, even if the solver is killed
+    unlink(&name[0]);
+
+    this->arcs = arcs;
+    blockArcs = options.blockArcs;
+    readAhead = options.readAhead;
+    maxPendingUpdates = options.maxPendingUpdates;
+    blocks = (arcs + blockArcs - 1) / blockArcs;
+
+    if (ftruncate(fd, (off_t)(arcs * sizeof(ExternalArc))) != 0){
+        close();
+        return false;
+    }
+
+    size_t frameCount = options.cacheBytes / (blockArcs * sizeof(ExternalArc));
+    if (frameCount < 2) frameCount = 2;
+    if ((long long)frameCount > blocks) frameCount = blocks > 0 ? blocks : 1;
+
+    frames.assign(frameCount, Frame());
+    for (size_t k = 0; k < frames.size(); k++){
+        frames[k].block = -1;
+        frames[k].dirty = false;
+        frames[k].referenced = false;
+    }
+
+    frameOfBlock.assign(blocks, -1);
+    pending.assign(blocks, std::vector<std::pair<int, int> >());
+    pendingUpdates = 0;
+    clockHand = 0;
+
+    blockReads = 0;
+    blockWrites = 0;
+    batchedUpdates = 0;
+
+    return true;
+
+}
+
+void ExternalArcStore::close(){
+
+    if (fd >= 0) ::close(fd);
+    fd = -1;
+
+    frames.clear();
+    frameOfBlock.clear();
+    pending.clear();
+
+}
+
+ExternalArc ExternalArcStore::read(long long a){
+
+    Frame& frame = load(a / blockArcs);
+    return frame.arcs[a % blockArcs];
+
+}
+
+void ExternalArcStore::write(long long a, const ExternalArc& arc){
+
+    Frame& frame = load(a / blockArcs);
+    frame.arcs[a % blockArcs] = arc;
+    frame.dirty = true;
+
+}
+
+void ExternalArcStore::addResidual(long long a, int delta){
+
+    long long block = a / blockArcs;
+
+    if (frameOfBlock[block] >= 0){
+        Frame& frame = frames[frameOfBlock[block]];
+        frame.arcs[a % blockArcs].residual += delta;
+        frame.dirty = true;
+        return;
+    }
+
+    pending[block].push_back(std::make_pair((int)(a % blockArcs), delta));
+    pendingUpdates++;
+    batchedUpdates++;
+
+    if (pendingUpdates > maxPendingUpdates) flushPending();
+
+}
+
+void ExternalArcStore::flush(){
+
+    flushPending();
+
+    for (size_t k = 0; k < frames.size(); k++){
+        if (frames[k].block >= 0 && frames[k].dirty){
+            long long block = frames[k].block;
+            size_t count = std::min((long long)blockArcs, arcs - block * blockArcs);
+            if (fullPwrite(fd, &frames[k].arcs[0], count * sizeof(ExternalArc), (off_t)(block * blockArcs * sizeof(ExternalArc)))){
+                blockWrites++;
+            }
+            frames[k].dirty = false;
+        }
+    }
+
+}
+
+ExternalArcStore::Frame& ExternalArcStore::load(long long block){
+
+    if (frameOfBlock[block] >= 0){
+        Frame& frame = frames[frameOfBlock[block]];
+        frame.referenced = true;
+        return frame;
+    }
+
+    // clock replacement: skip frames referenced since the hand last passed them
+
+    while (frames[clockHand].block >= 0 && frames[clockHand].referenced){
+        frames[clockHand].referenced = false;
+        clockHand = (clockHand + 1) % frames.size();
+    }
+
+    size_t k = clockHand;
+    clockHand = (clockHand + 1) % frames.size();
+
+    Frame& frame = frames[k];
+    evict(frame);
+
+    long long begin = block * blockArcs;
+    size_t count = std::min((long long)blockArcs, arcs - begin);
+
+    frame.arcs.resize(blockArcs);
+    if (!fullPread(fd, &frame.arcs[0], count * sizeof(ExternalArc), (off_t)(begin * sizeof(ExternalArc)))){
+        std::cout<<"Reading arc block "<<block<<" failed"<<std::endl;
+        std::abort();
+    }
+    blockReads++;
+
+    frame.block = block;
+    frame.dirty = false;
+    frame.referenced = true;
+    frameOfBlock[block] = k;
+
+    // apply the updates that were batched while the block was out
+    if (!pending[block].empty()){
+        for (size_t u = 0; u < pending[block].size(); u++){
+            frame.arcs[pending[block][u].first].residual += pending[block][u].second;
+        }
+        pendingUpdates -= pending[block].size();
+        std::vector<std::pair<int, int> >().swap(pending[block]);
+        frame.dirty = true;
+    }
+
+    // ask the kernel to start reading the next blocks, scans mostly move forward
+    long long ahead = std::min((long long)readAhead, blocks - block - 1);
+    if (ahead > 0){
+        posix_fadvise(fd, (off_t)((begin + blockArcs) * sizeof(ExternalArc)), (off_t)(ahead * blockArcs * sizeof(ExternalArc)), POSIX_FADV_WILLNEED);
+    }
+
+    return frame;
+
+}
+
+void ExternalArcStore::evict(Frame& frame){
+
+    if (frame.block < 0) return;
+
+    if (frame.dirty){
+        long long begin = frame.block * blockArcs;
+        size_t count = std::min((long long)blockArcs, arcs - begin);
+        if (!fullPwrite(fd, &frame.arcs[0], count * sizeof(ExternalArc), (off_t)(begin * sizeof(ExternalArc)))){
+            std::cout<<"Writing arc block "<<frame.block<<" failed"<<std::endl;
+            std::abort();
+        }
+        blockWrites++;
+    }
+
+    frameOfBlock[frame.block] = -1;
+    frame.block = -1;
+    frame.dirty = false;
+
+}
+
+void ExternalArcStore::flushPending(){
+
+    // loading a block applies its pending updates. blocks are visited in file order
+    for (long long block = 0; block < blocks && pendingUpdates > 0; block++){
+        if (!pending[block].empty()) load(block);
+    }
+
+}
+
+
+void setExternalMemoryOptions(const ExternalMemoryOptions& options){
+    externalMemoryOptions = options;
+}
+
+bool buildExternalNetwork(int n, const EdgeStream& edges, const ExternalMemoryOptions& options, ExternalNetwork& N){
+
+    N.n = n;
+    N.m = 0;
+
+    // first pass: degrees
+
+    std::vector<long long> degree(n, 0);
+    N.outDegree.assign(n, 0);
+
+    edges([&](int u, int w, int /*cap*/){
+        degree[u]++;
+        degree[w]++;
+        N.outDegree[u]++;
+        N.m++;
+    });
+
+    N.first.assign(n + 1, 0);
+    for (int v = 0; v < n; v++){
+        N.first[v + 1] = N.first[v] + degree[v];
+    }
+
+    if (!N.store.open(2 * N.m, options)) return false;
+
+    // second pass: place the arcs. degree is reused as the next free out slot, the in slots follow
+
+    std::vector<long long>& nextOut = degree;
+    std::vector<long long> nextIn(n);
+    for (int v = 0; v < n; v++){
+        nextOut[v] = N.first[v];
+        nextIn[v] = N.first[v] + N.outDegree[v];
+    }
+
+    edges([&](int u, int w, int cap){
+        long long a = nextOut[u]++;
+        long long b = nextIn[w]++;
+
+        ExternalArc forward = {w, cap, cap, 0, b};
+        ExternalArc reverse = {u, 0, cap, 0, a};
+
+        N.store.write(a, forward);
+        N.store.write(b, reverse);
+    });
+
+    N.store.flush();
+
+    return true;
+
+}
+
+bool externalShortestAugmentedPath(ExternalNetwork& N, int s, int t){
+
+    int n = N.n;
+    ExternalArcStore& store = N.store;
+
+    // exact distance labels with a reverse bfs. the residual of v->w is cap - residual of the arc w->v
+
+    std::vector<int> d(n, n);
+    std::vector<int> queue;
+    queue.reserve(n);
+
+    d[t] = 0;
+    queue.push_back(t);
+
+    for (size_t q = 0; q < queue.size(); q++){
+        int w = queue[q];
+        for (long long a = N.first[w]; a < N.first[w + 1]; a++){
+            ExternalArc arc = store.read(a);
+            if (d[arc.head] != n || arc.cap - arc.residual <= 0) continue;
+            d[arc.head] = d[w] + 1;
+            queue.push_back(arc.head);
+        }
+    }
+    std::vector<int>().swap(queue);
+
+    if (d[s] >= n) return false;
+
+    std::vector<int> count(n + 1, 0);
+    for (int v = 0; v < n; v++){
+        count[d[v]]++;
+    }
+
+    std::vector<long long> current(N.first.begin(), N.first.end() - 1);
+    std::vector<int> pred(n, -1);
+    std::vector<long long> predArc(n, -1);
+    std::vector<long long> predMate(n, -1);
+    std::vector<int> predResidual(n, 0);
+
+    int i = s;
+
+    while (d[s] < n){
+
+        // advance
+
+        bool arcFound = false;
+
+        for (long long a = current[i]; a < N.first[i + 1]; a++){
+            ExternalArc arc = store.read(a);
+            if (arc.residual <= 0 || d[arc.head] != d[i] - 1) continue;
+
+            // the residual of the path arcs can only change when the path is augmented,
+            // so it is remembered here instead of being read again
+            int j = arc.head;
+            current[i] = a;
+            pred[j] = i;
+            predArc[j] = a;
+            predMate[j] = arc.mate;
+            predResidual[j] = arc.residual;
+            i = j;
+
+            arcFound = true;
+            break;
+        }
+
+        if (arcFound){
+
+            if (i != t) continue;
+
+            int delta = INT_MAX;
+            for (int v = t; v != s; v = pred[v]){
+                if (predResidual[v] < delta) delta = predResidual[v];
+            }
+
+            for (int v = t; v != s; v = pred[v]){
+                store.addResidual(predArc[v], -delta);
+                store.addResidual(predMate[v], delta);
+            }
+
+            i = s;
+            continue;
+        }
+
+        // retreat
+
+        int mind = INT_MAX;
+        for (long long a = N.first[i]; a < N.first[i + 1]; a++){
+            ExternalArc arc = store.read(a);
+            if (arc.residual > 0 && d[arc.head] < mind) mind = d[arc.head];
+        }
+        int newD = mind >= n ? n : mind + 1;
+
+        count[d[i]]--;
+        if (count[d[i]] == 0) break;
+
+        d[i] = newD;
+        count[newD]++;
+        current[i] = N.first[i];
+
+        if (i != s) i = pred[i];
+
+    }
+
+    store.flush();
+
+    return true;
+
+}
+
+void forEachExternalEdgeFlow(ExternalNetwork& N, const EdgeStream& edges, const std::function<void(long long k, int flow)>& flow){
+
+    std::vector<long long> nextOut(N.first.begin(), N.first.end() - 1);
+    long long k = 0;
+
+    edges([&](int u, int /*w*/, int /*cap*/){
+        ExternalArc arc = N.store.read(nextOut[u]++);
+        flow(k++, arc.cap - arc.residual);
+    });
+
+}
+
+bool externalShortestAugmentedPath(Graph& G, Vertex s, Vertex t){
+
+    int n = num_vertices(G);
+
+    OutEdgeIterator out_e_it, out_e_it_end;
+
+    EdgeStream edges = [&G, n](const std::function<void(int u, int w, int cap)>& visit){
+        OutEdgeIterator it, it_end;
+        for (int v = 0; v < n; v++){
+            for (tie(it, it_end) = out_edges(v, G); it != it_end; it++){
+                visit(v, target(*it, G), G[*it].cap);
+            }
+        }
+    };
+
+    ExternalNetwork N;
+    if (!buildExternalNetwork(n, edges, externalMemoryOptions, N)){
+        std::cout<<"Could not create the arc file in "<<externalMemoryOptions.directory<<std::endl;
+        return false;
+    }
+
+    if (!externalShortestAugmentedPath(N, s, t)){
+        std::cout<<"t is not reachable from s"<<std::endl;
+        return false;
+    }
+
+    // the edges are listed in the same order again, so the k-th flow belongs to the k-th out edge
+
+    std::vector<Edge> order;
+    order.reserve(N.m);
+    for (int v = 0; v < n; v++){
+        for (tie(out_e_it, out_e_it_end) = out_edges(v, G); out_e_it != out_e_it_end; out_e_it++){
+            order.push_back(*out_e_it);
+        }
+    }
+
+    forEachExternalEdgeFlow(N, edges, [&](long long k, int flow){
+        G[order[k]].f = flow;
+    });
+
+    return true;
+
+}
+
+
+bool fullPread(int fd, void* buffer, size_t bytes, off_t offset){
+
+    char* p = (char*)buffer;
+    while (bytes > 0){
+        ssize_t got = pread(fd, p, bytes, offset);
+        if (got <= 0) return false;
+        p += got;
+        bytes -= got;
+        offset += got;
+    }
+    return true;
+
+}
+
+bool fullPwrite(int fd, const void* buffer, size_t bytes, off_t offset){
+
+    const char* p = (const char*)buffer;
+    while (bytes > 0){
+        ssize_t put = pwrite(fd, p, bytes, offset);
+        if (put <= 0) return false;
+        p += put;
+        bytes -= put;
+        offset += put;
+    }
+    return true;
+
+}
@@ -0,0 +1,99 @@
+#include "boostGraphStruct.hpp"
+#include "flatNetwork.hpp"
+
+using namespace boost;
+
+void buildFlatNetwork(Graph& G, FlatNetwork& N){
+    buildFlatNetwork(G, std::vector<int>(), N);
+}
+
+void buildFlatNetwork(Graph& G, const std::vector<int>& index, FlatNetwork& N){
+
+    // an empty index keeps the vertex numbers of G
+    bool identity = index.empty();
+
+    int n = num_vertices(G);
+    int m = num_edges(G);
+
+    OutEdgeIterator out_e_it, out_e_it_end;
+
+    N.n = n;
+    N.m = m;
+
+    N.edges.clear();
+    N.edges.reserve(m);
+
+    // number the edges by source, the order edges(G) visits them in
+
+    std::vector<int> degree(n, 0);
+    std::vector<int> outDegree(n, 0);
+
+    for (int v = 0; v < n; v++){
+        int x = identity ? v : index[v];
+        for (tie(out_e_it, out_e_it_end) = out_edges(v, G); out_e_it != out_e_it_end; out_e_it++){
+            int w = target(*out_e_it, G);
+            N.edges.push_back(*out_e_it);
+            degree[x]++;
+            degree[identity ? w : index[w]]++;
+        }
+        outDegree[x] = out_degree(v, G);
+    }
+
+    N.first.assign(n + 1, 0);
+    for (int v = 0; v < n; v++){
+        N.first[v + 1] = N.first[v] + degree[v];
+    }
+
+    N.head.assign(2 * m, 0);
+    N.residual.assign(2 * m, 0);
+    N.mate.assign(2 * m, 0);
+    N.forwardArc.assign(m, 0);
+
+    // next free out arc and in arc slot of every vertex
+    std::vector<int> nextOut(n);
+    std::vector<int> nextIn(n);
+    for (int v = 0; v < n; v++){
+        nextOut[v] = N.first[v];
+        nextIn[v] = N.first[v] + outDegree[v];
+    }
+
+    for (int k = 0; k < m; k++){
+        Edge e = N.edges[k];
+        int u = identity ? source(e, G) : index[source(e, G)];
+        int w = identity ? target(e, G) : index[target(e, G)];
+
+        int a = nextOut[u]++;
+        int b = nextIn[w]++;
+
+        N.head[a] = w;
+        N.head[b] = u;
+        N.residual[a] = G[e].cap - G[e].f;
+        N.residual[b] = G[e].f;
+        N.mate[a] = b;
+        N.mate[b] = a;
+        N.forwardArc[k] = a;
+    }
+
+}
+
+void writeFlatFlow(Graph& G, const FlatNetwork& N){
+
+    for (int k = 0; k < N.m; k++){
+        G[N.edges[k]].f = flatEdgeFlow(N, k);
+    }
+
+}
+
+long long flatFlowValue(const FlatNetwork& N, int s){
+
+    long long value = 0;
+
+    for (int k = 0; k < N.m; k++){
+        int a = N.forwardArc[k];
+        if (flatArcTail(N, a) == s) value += flatEdgeFlow(N, k);
+        if (N.head[a] == s) value -= flatEdgeFlow(N, k);
+    }
+
+    return value;
+
+}
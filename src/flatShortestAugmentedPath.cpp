@@ -0,0 +1,180 @@
+#include <iostream>
+#include "boostGraphStruct.hpp"
+#include "flatShortestAugmentedPath.hpp"
+#include "arcScan.hpp"
+#include "solverWorkspace.hpp"
+#include <climits>
+
+using namespace boost;
+
+// augments along the path stored in pred from s to t and returns the amount of flow sent
+int flatAugment(FlatNetwork& N, int s, int t, BulkVector<int>& pred);
+
+
+bool flatShortestAugmentedPath(Graph& G, Vertex s, Vertex t){
+    return flatShortestAugmentedPath(G, s, t, threadWorkspace());
+}
+
+bool flatShortestAugmentedPath(Graph& G, Vertex s, Vertex t, SolverWorkspace& ws){
+
+    EdgeIterator e_it, e_it_end;
+
+    // flow = 0
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+        G[*e_it].f = 0;
+    }
+
+    // the network of the last call is rebuilt in place, its arrays keep their capacity
+    FlatNetwork& N = ws.network;
+    buildFlatNetwork(G, N);
+
+    if (!flatShortestAugmentedPath(N, s, t, NULL, ws)){
+        std::cout<<"t is not reachable from s"<<std::endl;
+        return false;
+    }
+
+    writeFlatFlow(G, N);
+
+    return true;
+
+}
+
+bool flatShortestAugmentedPath(FlatNetwork& N, int s, int t){
+    return flatShortestAugmentedPath(N, s, t, NULL);
+}
+
+bool flatShortestAugmentedPath(FlatNetwork& N, int s, int t, const FlatSolverMonitor* monitor){
+    return flatShortestAugmentedPath(N, s, t, monitor, threadWorkspace());
+}
+
+bool flatShortestAugmentedPath(FlatNetwork& N, int s, int t, const FlatSolverMonitor* monitor, SolverWorkspace& ws){
+
+    int n = N.n;
+
+    BulkVector<int>& d = ws.labels;
+    flatExactLabels(N, t, d, ws.current);
+
+    if (d[s] >= n) return false;
+
+    // number of vertices with each label, for the gap test
+    BulkVector<int>& count = ws.count;
+    count.assign(n + 1, 0);
+    for (int v = 0; v < n; v++){
+        count[d[v]]++;
+    }
+
+    BulkVector<int>& current = ws.current;
+    current.assign(N.first.begin(), N.first.end() - 1);
+    BulkVector<int>& pred = ws.arcPred;    // arc the vertex was reached with
+    pred.assign(n, -1);
+
+    const int* head = N.head.data();
+    const int* residual = N.residual.data();
+    const int* first = N.first.data();
+
+    FlatSolveProgress progress;
+    progress.flow = monitor ? flatFlowValue(N, s) : 0;
+    progress.iterations = 0;
+    progress.augmentations = 0;
+    progress.d = &d;
+
+    int i = s;
+
+    while (d[s] < n){
+
+        if (monitor && ++progress.iterations % monitor->every == 0){
+            progress.sourceLabel = d[s];
+            if (!monitor->check(progress)) break;
+        }
+
+        // advance
+
+        int a = admissibleArcScan(head, residual, d.data(), current[i], first[i + 1], d[i] - 1);
+
+        if (a < first[i + 1]){
+
+            current[i] = a;
+
+            int j = head[a];
+            pred[j] = a;
+            i = j;
+
+            if (i == t){
+                progress.flow += flatAugment(N, s, t, pred);
+                progress.augmentations++;
+                i = s;
+            }
+
+            continue;
+        }
+
+        // retreat
+
+        int mind = minLabelScan(head, residual, d.data(), first[i], first[i + 1]);
+        int newD = mind >= n ? n : mind + 1;
+
+        count[d[i]]--;
+
+        // no vertex is left with the old label of i, so s is cut off from t
+        if (count[d[i]] == 0) break;
+
+        d[i] = newD;
+        count[newD]++;
+        current[i] = first[i];
+
+        if (i != s){
+            i = flatArcTail(N, pred[i]);
+        }
+
+    }
+
+    return true;
+
+}
+
+void flatExactLabels(const FlatNetwork& N, int t, BulkVector<int>& d){
+    BulkVector<int> queue;
+    flatExactLabels(N, t, d, queue);
+}
+
+void flatExactLabels(const FlatNetwork& N, int t, BulkVector<int>& d, BulkVector<int>& queue){
+
+    int n = N.n;
+
+    d.assign(n, n);
+    d[t] = 0;
+
+    // v gets a label from w if the residual arc v->w exists, which is the mate of an arc of w
+    queue.clear();
+    queue.reserve(n);
+    queue.push_back(t);
+
+    for (size_t q = 0; q < queue.size(); q++){
+        int w = queue[q];
+        for (int a = N.first[w]; a < N.first[w + 1]; a++){
+            int v = N.head[a];
+            if (d[v] != n || N.residual[N.mate[a]] <= 0) continue;
+            d[v] = d[w] + 1;
+            queue.push_back(v);
+        }
+    }
+
+}
+
+
+int flatAugment(FlatNetwork& N, int s, int t, BulkVector<int>& pred){
+
+    int delta = INT_MAX;
+
+    for (int v = t; v != s; v = flatArcTail(N, pred[v])){
+        if (N.residual[pred[v]] < delta) delta = N.residual[pred[v]];
+    }
+
+    for (int v = t; v != s; v = flatArcTail(N, pred[v])){
+        N.residual[pred[v]] -= delta;
+        N.residual[N.mate[pred[v]]] += delta;
+    }
+
+    return delta;
+
+}
@@ -0,0 +1,217 @@
+#include <iostream>
+#include "boostGraphStruct.hpp"
+#include "flowCache.hpp"
+
+using namespace boost;
+
+// list and hash map nodes of an entry on top of the entry itself
+const size_t ENTRY_OVERHEAD = 64;
+
+// layouts are never reused, also not between fingerprints of different graphs
+uint64_t nextLayout = 1;
+
+// splitmix64 finalizer
+inline uint64_t mixHash(uint64_t x){
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+inline uint64_t edgeHash(int u, int w, int cap){
+    return mixHash(mixHash(((uint64_t)(uint32_t)u << 32) | (uint32_t)w) ^ (uint32_t)cap);
+}
+
+inline uint64_t queryKey(uint64_t fingerprint, int s, int t){
+    return mixHash(fingerprint ^ mixHash(((uint64_t)(uint32_t)s << 32) | (uint32_t)t));
+}
+
+
+GraphFingerprint::GraphFingerprint(Graph& G) : G(G), layoutId(nextLayout++){
+
+    EdgeIterator e_it, e_it_end;
+
+    // the number of vertices is part of the graph, even the ones without edges
+    hash = mixHash(num_vertices(G));
+
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+        hash += edgeHash(source(*e_it, G), target(*e_it, G), G[*e_it].cap);
+    }
+
+}
+
+void GraphFingerprint::setCapacity(Edge e, int cap){
+
+    int u = source(e, G);
+    int w = target(e, G);
+
+    hash -= edgeHash(u, w, G[e].cap);
+    hash += edgeHash(u, w, cap);
+    G[e].cap = cap;
+
+}
+
+Edge GraphFingerprint::insertEdge(Vertex u, Vertex w, int cap){
+
+    Edge e = add_edge(u, w, G).first;
+    G[e].cap = cap;
+    G[e].f = 0;
+
+    hash += edgeHash(u, w, cap);
+    layoutId = nextLayout++;
+
+    return e;
+
+}
+
+void GraphFingerprint::deleteEdge(Edge e){
+
+    hash -= edgeHash(source(e, G), target(e, G), G[e].cap);
+    layoutId = nextLayout++;
+
+    remove_edge(e, G);
+
+}
+
+size_t FlowCacheEntry::bytes() const{
+    return sizeof(FlowCacheEntry) + ENTRY_OVERHEAD + sourceSide.capacity() * sizeof(uint64_t) + flows.capacity() * sizeof(int);
+}
+
+FlowCache::FlowCache(size_t budgetBytes, bool storeFlows) : hits(0), misses(0), evictions(0), budget(budgetBytes), storeFlows(storeFlows), used(0){}
+
+const FlowCacheEntry* FlowCache::lookup(uint64_t fingerprint, Vertex s, Vertex t){
+
+    std::unordered_map<uint64_t, std::list<FlowCacheEntry>::iterator>::iterator k = index.find(queryKey(fingerprint, s, t));
+
+    if (k == index.end() || k->second->fingerprint != fingerprint || k->second->s != (int)s || k->second->t != (int)t){
+        misses++;
+        return NULL;
+    }
+
+    hits++;
+    lru.splice(lru.begin(), lru, k->second);
+
+    return &lru.front();
+
+}
+
+long long FlowCache::store(Graph& G, Vertex s, Vertex t, const GraphFingerprint& fingerprint){
+
+    EdgeIterator e_it, e_it_end;
+    OutEdgeIterator out_e_it, out_e_it_end;
+    InEdgeIterator in_e_it, in_e_it_end;
+
+    int n = num_vertices(G);
+    uint64_t key = queryKey(fingerprint.value(), s, t);
+
+    FlowCacheEntry entry;
+    entry.fingerprint = fingerprint.value();
+    entry.s = s;
+    entry.t = t;
+    entry.flow = 0;
+    entry.layout = fingerprint.layout();
+
+    // the s side of the min cut is what s reaches in the residual graph
+    entry.sourceSide.assign((n + 63) / 64, 0);
+    entry.sourceSide[s >> 6] |= 1ULL << (s & 63);
+
+    std::vector<int> queue(1, s);
+
+    for (size_t q = 0; q < queue.size(); q++){
+        int v = queue[q];
+        for (tie(out_e_it, out_e_it_end) = out_edges(v, G); out_e_it != out_e_it_end; out_e_it++){
+            int w = target(*out_e_it, G);
+            if (G[*out_e_it].f >= G[*out_e_it].cap || entry.onSourceSide(w)) continue;
+            entry.sourceSide[w >> 6] |= 1ULL << (w & 63);
+            queue.push_back(w);
+        }
+        for (tie(in_e_it, in_e_it_end) = in_edges(v, G); in_e_it != in_e_it_end; in_e_it++){
+            int w = source(*in_e_it, G);
+            if (G[*in_e_it].f <= 0 || entry.onSourceSide(w)) continue;
+            entry.sourceSide[w >> 6] |= 1ULL << (w & 63);
+            queue.push_back(w);
+        }
+    }
+
+    for (tie(out_e_it, out_e_it_end) = out_edges(s, G); out_e_it != out_e_it_end; out_e_it++){
+        entry.flow += G[*out_e_it].f;
+    }
+    for (tie(in_e_it, in_e_it_end) = in_edges(s, G); in_e_it != in_e_it_end; in_e_it++){
+        entry.flow -= G[*in_e_it].f;
+    }
+
+    if (storeFlows){
+        entry.flows.reserve(num_edges(G));
+        for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+            entry.flows.push_back(G[*e_it].f);
+        }
+    }
+
+    // an entry larger than the whole budget is kept without its flows, or not at all
+    if (entry.bytes() > budget) std::vector<int>().swap(entry.flows);
+    if (entry.bytes() > budget) return entry.flow;
+
+    std::unordered_map<uint64_t, std::list<FlowCacheEntry>::iterator>::iterator k = index.find(key);
+    if (k != index.end()){
+        used -= k->second->bytes();
+        lru.erase(k->second);
+        index.erase(k);
+    }
+
+    evict(entry.bytes());
+
+    used += entry.bytes();
+    lru.push_front(std::move(entry));
+    index[key] = lru.begin();
+
+    return lru.front().flow;
+
+}
+
+void FlowCache::clear(){
+    lru.clear();
+    index.clear();
+    used = 0;
+}
+
+void FlowCache::evict(size_t extra){
+
+    while (!lru.empty() && used + extra > budget){
+        const FlowCacheEntry& last = lru.back();
+        used -= last.bytes();
+        index.erase(queryKey(last.fingerprint, last.s, last.t));
+        lru.pop_back();
+        evictions++;
+    }
+
+}
+
+long long cachedMaxFlow(Graph& G, Vertex s, Vertex t, const GraphFingerprint& fingerprint, FlowCache& cache, MaxFlowSolver solver, bool needFlows){
+
+    EdgeIterator e_it, e_it_end;
+
+    const FlowCacheEntry* entry = cache.lookup(fingerprint.value(), s, t);
+    bool haveFlows = entry && !entry->flows.empty() && entry->layout == fingerprint.layout();
+
+    if (entry && (haveFlows || !needFlows)){
+        if (haveFlows){
+            size_t k = 0;
+            for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+                G[*e_it].f = entry->flows[k++];
+            }
+        }
+        return entry->flow;
+    }
+
+    // a hit without the flows that were asked for
+    if (entry){
+        cache.hits--;
+        cache.misses++;
+    }
+
+    // an unreachable t is stored as well, with zero flow
+    solver(G, s, t);
+
+    return cache.store(G, s, t, fingerprint);
+
+}
@@ -0,0 +1,304 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include "flowProtocol.hpp"
+
+// client of flowServer. without --load it sends one query and prints the answer:
+//   flowClient [--socket=PATH] [--graph=G] [--s=S --t=T] info|maxflow|mincut|check=VALUE|shutdown
+// with --load it is a load generator: --connections clients each keep up to --depth queries of
+// --op between random vertex pairs in flight until --queries have been answered in total, and the
+// throughput and the percentiles of the latency from send to response are printed next to the
+// solve time the server reports, which shows how much of the latency is the solve itself
+
+struct LoadOptions
+{
+    std::string socketPath;
+    int graph;
+    int op;
+    int connections;
+    int queries;
+    int depth;
+    unsigned seed;
+};
+
+// what one connection of the load generator measured
+struct LoadResult
+{
+    std::vector<double> latency;        // us from send to response, per query
+    long long solveMicros;
+    long long errors;
+    bool failed;
+};
+
+// sends one request and reads its response and the min cut edges, if any
+bool query(int fd, const FlowRequest& request, FlowResponse& response, std::vector<int32_t>& cut);
+
+// one connection of the load generator, answering [queries] queries of a graph with [n] vertices
+void loadConnection(const LoadOptions& options, int n, int queries, unsigned seed, LoadResult& result);
+
+// runs the load generator and prints its report
+int runLoad(const LoadOptions& options);
+
+
+int main(int argc, char* argv[])
+{
+
+    LoadOptions options;
+    options.socketPath = DEFAULT_FLOW_SOCKET;
+    options.graph = 0;
+    options.op = FLOW_OP_MAX_FLOW;
+    options.connections = 4;
+    options.queries = 10000;
+    options.depth = 1;
+    options.seed = 1;
+
+    bool load = false;
+
+    FlowRequest request;
+    memset(&request, 0, sizeof(request));
+    request.s = -1;
+    request.t = -1;
+
+    for (int a = 1; a < argc; a++){
+        std::string arg = argv[a];
+
+        if (arg.compare(0, 9, "--socket=") == 0) options.socketPath = arg.substr(9);
+        else if (arg.compare(0, 8, "--graph=") == 0) options.graph = atoi(arg.c_str() + 8);
+        else if (arg.compare(0, 4, "--s=") == 0) request.s = atoi(arg.c_str() + 4);
+        else if (arg.compare(0, 4, "--t=") == 0) request.t = atoi(arg.c_str() + 4);
+        else if (arg == "--load") load = true;
+        else if (arg.compare(0, 14, "--connections=") == 0) options.connections = std::max(1, atoi(arg.c_str() + 14));
+        else if (arg.compare(0, 10, "--queries=") == 0) options.queries = std::max(1, atoi(arg.c_str() + 10));
+        else if (arg.compare(0, 8, "--depth=") == 0) options.depth = std::max(1, atoi(arg.c_str() + 8));
+        else if (arg.compare(0, 7, "--seed=") == 0) options.seed = strtoul(arg.c_str() + 7, NULL, 10);
+        else if (arg == "--op=maxflow") options.op = FLOW_OP_MAX_FLOW;
+        else if (arg == "--op=mincut") options.op = FLOW_OP_MIN_CUT;
+        else if (arg == "info") request.op = FLOW_OP_INFO;
+        else if (arg == "maxflow") request.op = FLOW_OP_MAX_FLOW;
+        else if (arg == "mincut") request.op = FLOW_OP_MIN_CUT;
+        else if (arg == "shutdown") request.op = FLOW_OP_SHUTDOWN;
+        else if (arg.compare(0, 6, "check=") == 0){
+            request.op = FLOW_OP_CHECK;
+            request.value = atoll(arg.c_str() + 6);
+        }
+        else{
+            std::cout<<"Unknown option "<<arg<<std::endl;
+            std::cout<<"Usage: flowClient [--socket=PATH] [--graph=G] [--s=S --t=T] info|maxflow|mincut|check=VALUE|shutdown"<<std::endl;
+            std::cout<<"       flowClient --load [--socket=PATH] [--graph=G] [--op=maxflow|mincut] [--connections=C] [--queries=Q] [--depth=D] [--seed=S]"<<std::endl;
+            return 1;
+        }
+    }
+
+    if (load) return runLoad(options);
+
+    if (request.op == 0){
+        std::cout<<"Give one of info, maxflow, mincut, check=VALUE or shutdown"<<std::endl;
+        return 1;
+    }
+
+    int fd = connectFlowServer(options.socketPath);
+    if (fd < 0) return 1;
+
+    request.graph = options.graph;
+
+    FlowResponse response;
+    std::vector<int32_t> cut;
+
+    if (!query(fd, request, response, cut)){
+        std::cout<<"The server closed the connection"<<std::endl;
+        close(fd);
+        return 1;
+    }
+
+    close(fd);
+
+    if (response.status != FLOW_OK && response.status != FLOW_CHECK_FAILED){
+        std::cout<<flowOpName(request.op)<<" failed: "<<flowStatusName(response.status)<<std::endl;
+        return 1;
+    }
+
+    switch (request.op){
+        case FLOW_OP_INFO:
+            std::cout<<"Graph "<<request.graph<<": "<<response.flow<<" vertices, "<<response.count<<" edges"<<std::endl;
+            break;
+        case FLOW_OP_MAX_FLOW:
+            std::cout<<"Max flow "<<response.flow<<", solved in "<<response.solveMicros<<" us"<<std::endl;
+            break;
+        case FLOW_OP_MIN_CUT:
+            std::cout<<"Min cut of capacity "<<response.flow<<" with "<<response.count<<" edges, solved in "<<response.solveMicros<<" us"<<std::endl;
+            for (size_t k = 0; k < cut.size(); k += 2){
+                std::cout<<"  "<<cut[k]<<" -> "<<cut[k + 1]<<std::endl;
+            }
+            break;
+        case FLOW_OP_CHECK:
+            if (response.status == FLOW_OK) std::cout<<request.value<<" is the max flow"<<std::endl;
+            else std::cout<<request.value<<" is not the max flow, the max flow is "<<response.flow<<std::endl;
+            return response.status == FLOW_OK ? 0 : 2;
+        case FLOW_OP_SHUTDOWN:
+            std::cout<<"The server is shutting down"<<std::endl;
+            break;
+    }
+
+    return 0;
+
+}
+
+bool query(int fd, const FlowRequest& request, FlowResponse& response, std::vector<int32_t>& cut){
+
+    if (!writeFully(fd, &request, sizeof(request)) || !readFully(fd, &response, sizeof(response))) return false;
+
+    cut.resize(response.op == FLOW_OP_MIN_CUT ? 2 * (size_t)response.count : 0);
+    return cut.empty() || readFully(fd, cut.data(), cut.size() * sizeof(int32_t));
+
+}
+
+void loadConnection(const LoadOptions& options, int n, int queries, unsigned seed, LoadResult& result){
+
+    result.solveMicros = 0;
+    result.errors = 0;
+    result.failed = true;
+
+    int fd = connectFlowServer(options.socketPath);
+    if (fd < 0) return;
+
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<int> vertex(0, n - 1);
+
+    // send time of every query by id
+    std::vector<std::chrono::steady_clock::time_point> sentAt(queries);
+    std::vector<int32_t> cut;
+
+    FlowRequest request;
+    memset(&request, 0, sizeof(request));
+    request.op = options.op;
+    request.graph = options.graph;
+
+    int sent = 0;
+    int answered = 0;
+
+    while (answered < queries){
+        // keep [depth] queries in flight
+        while (sent < queries && sent - answered < options.depth){
+            request.id = sent;
+            request.s = vertex(random);
+            do request.t = vertex(random); while (request.t == request.s);
+
+            sentAt[sent] = std::chrono::steady_clock::now();
+            if (!writeFully(fd, &request, sizeof(request))){
+                close(fd);
+                return;
+            }
+            sent++;
+        }
+
+        FlowResponse response;
+        if (!readFully(fd, &response, sizeof(response))) break;
+
+        cut.resize(response.op == FLOW_OP_MIN_CUT ? 2 * (size_t)response.count : 0);
+        if (!cut.empty() && !readFully(fd, cut.data(), cut.size() * sizeof(int32_t))) break;
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (response.id < (uint32_t)queries){
+            result.latency.push_back(std::chrono::duration<double, std::micro>(now - sentAt[response.id]).count());
+        }
+
+        result.solveMicros += response.solveMicros;
+        if (response.status != FLOW_OK) result.errors++;
+        answered++;
+    }
+
+    result.failed = answered < queries;
+    close(fd);
+
+}
+
+int runLoad(const LoadOptions& options){
+
+    // the vertex count of the graph for the random pairs
+    int fd = connectFlowServer(options.socketPath);
+    if (fd < 0) return 1;
+
+    FlowRequest request;
+    memset(&request, 0, sizeof(request));
+    request.op = FLOW_OP_INFO;
+    request.graph = options.graph;
+
+    FlowResponse info;
+    std::vector<int32_t> unused;
+    bool answered = query(fd, request, info, unused);
+    close(fd);
+
+    if (!answered || info.status != FLOW_OK || info.flow < 2){
+        std::cout<<"Graph "<<options.graph<<" is not served"<<std::endl;
+        return 1;
+    }
+
+    int n = info.flow;
+
+    std::cout<<"Load on graph "<<options.graph<<" ("<<n<<" vertices, "<<info.count<<" edges): "<<options.queries<<" "<<flowOpName(options.op)<<" queries over ";
+    std::cout<<options.connections<<" connection(s), "<<options.depth<<" in flight per connection"<<std::endl;
+
+    std::vector<LoadResult> results(options.connections);
+    std::vector<std::thread> clients;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (int c = 0; c < options.connections; c++){
+        // the queries are split as evenly as possible
+        int share = options.queries / options.connections + (c < options.queries % options.connections ? 1 : 0);
+        clients.push_back(std::thread(loadConnection, std::cref(options), n, share, options.seed + c, std::ref(results[c])));
+    }
+
+    for (size_t c = 0; c < clients.size(); c++){
+        clients[c].join();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<double> latency;
+    long long solveMicros = 0;
+    long long errors = 0;
+    int failed = 0;
+
+    for (size_t c = 0; c < results.size(); c++){
+        latency.insert(latency.end(), results[c].latency.begin(), results[c].latency.end());
+        solveMicros += results[c].solveMicros;
+        errors += results[c].errors;
+        if (results[c].failed) failed++;
+    }
+
+    if (failed > 0) std::cout<<failed<<" connection(s) were closed before all of their queries were answered"<<std::endl;
+
+    if (latency.empty()) return 1;
+
+    std::sort(latency.begin(), latency.end());
+
+    double mean = 0;
+    for (size_t k = 0; k < latency.size(); k++){
+        mean += latency[k];
+    }
+    mean /= latency.size();
+
+    // nearest rank percentile
+    auto percentile = [&](double p){
+        size_t rank = (size_t)(p / 100 * latency.size() + 0.5);
+        return latency[std::min(latency.size() - 1, rank > 0 ? rank - 1 : 0)];
+    };
+
+    std::cout<<"Answered "<<latency.size()<<" queries in "<<seconds<<" s: "<<latency.size() / seconds<<" queries/s";
+    if (errors > 0) std::cout<<", "<<errors<<" with an error status";
+    std::cout<<std::endl;
+
+    std::cout<<"Latency (us): mean "<<mean<<", p50 "<<percentile(50)<<", p90 "<<percentile(90)<<", p99 "<<percentile(99)<<", max "<<latency.back()<<std::endl;
+    std::cout<<"Server solve time (us): mean "<<(double)solveMicros / latency.size()<<std::endl;
+
+    return failed > 0 ? 1 : 0;
+
+}
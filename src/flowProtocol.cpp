@@ -0,0 +1,80 @@
+#include <iostream>
+#include "flowProtocol.hpp"
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+
+bool readFully(int fd, void* data, size_t bytes){
+
+    char* p = (char*)data;
+
+    while (bytes > 0){
+        ssize_t got = read(fd, p, bytes);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) return false;
+        p += got;
+        bytes -= got;
+    }
+
+    return true;
+
+}
+
+bool writeFully(int fd, const void* data, size_t bytes){
+
+    const char* p = (const char*)data;
+
+    while (bytes > 0){
+        // MSG_NOSIGNAL: a client that went away is an error here, not a SIGPIPE
+        ssize_t sent = send(fd, p, bytes, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent <= 0) return false;
+        p += sent;
+        bytes -= sent;
+    }
+
+    return true;
+
+}
+
+int connectFlowServer(const std::string& path){
+
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (path.size() >= sizeof(address.sun_path)){
+        std::cout<<"Socket path "<<path<<" is too long"<<std::endl;
+        return -1;
+    }
+    strcpy(address.sun_path, path.c_str());
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (sockaddr*)&address, sizeof(address)) < 0){
+        std::cout<<"Could not connect to "<<path<<" ("<<strerror(errno)<<")"<<std::endl;
+        if (fd >= 0) close(fd);
+        return -1;
+    }
+
+    return fd;
+
+}
+
+const char* flowOpName(int op){
+
+    static const char* names[] = {"unknown", "info", "maxflow", "mincut", "check", "shutdown"};
+
+    return op >= FLOW_OP_INFO && op <= FLOW_OP_SHUTDOWN ? names[op] : names[0];
+
+}
+
+const char* flowStatusName(int status){
+
+    static const char* names[] = {"ok", "bad op", "bad graph", "bad vertex", "check failed"};
+
+    return status >= FLOW_OK && status <= FLOW_CHECK_FAILED ? names[status] : "unknown";
+
+}
@@ -0,0 +1,501 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <set>
+#include <memory>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <system_error>
+#include <csignal>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "boostGraphStruct.hpp"
+#include "flatNetwork.hpp"
+#include "flatShortestAugmentedPath.hpp"
+#include "solverWorkspace.hpp"
+#include "benchmarkPipeline.hpp"
+#include "graphGenerators.hpp"
+#include "graphFormats.hpp"
+#include "flowProtocol.hpp"
+
+using namespace boost;
+
+// keeps graphs loaded and answers max flow, min cut and check queries of flowProtocol.hpp on a Unix
+// domain socket, so a query pays for its solve and not for reading, generating or converting the
+// graph. every graph is loaded once at startup and turned into a FlatNetwork with zero flow. each
+// connection has a detached reader thread that puts its requests on one queue. a worker takes its
+// share of what is queued, split with the workers that are waiting and at most --batch, sorted by
+// graph, so that a burst is spread over the pool and the worker's copy of a network stays in cache
+// between the queries on it. a worker solves a query on
+// its own copy of the network, reset to zero flow from the loaded one, with
+// flatShortestAugmentedPath and the worker's SolverWorkspace, and writes the response as soon as
+// it is solved. does not need LEDA
+
+struct ResidentGraph
+{
+    std::string name;
+    Graph G;
+    Vertex s;
+    Vertex t;
+    FlatNetwork base;       // zero flow
+};
+
+// one client. the socket is closed when the reader is done and the last queued query of the
+// connection is answered, whichever is later
+struct Connection
+{
+    int fd;
+    std::mutex writeMutex;  // responses of different workers must not interleave
+
+    explicit Connection(int fd) : fd(fd) {}
+    ~Connection(){ close(fd); }
+};
+
+struct QueuedQuery
+{
+    std::shared_ptr<Connection> from;
+    FlowRequest request;
+};
+
+// queue of all connections. popBatch blocks until there is a query or the queue is closed
+class QueryQueue
+{
+public:
+    QueryQueue() : idle(0), closed(false) {}
+
+    void push(const QueuedQuery& query)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        queries.push_back(query);
+        notEmpty.notify_one();
+    }
+
+    // moves queries to [batch]: the caller's share of the queue split with the workers that are
+    // still waiting, at least one and at most [maxQueries]. returns false once the queue is closed
+    // and empty
+    bool popBatch(std::vector<QueuedQuery>& batch, size_t maxQueries)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle++;
+        notEmpty.wait(lock, [this]{ return closed || !queries.empty(); });
+        idle--;
+
+        size_t share = (queries.size() + idle) / (idle + 1);
+        size_t take = std::min(maxQueries, std::max<size_t>(1, share));
+
+        batch.clear();
+        while (!queries.empty() && batch.size() < take){
+            batch.push_back(queries.front());
+            queries.pop_front();
+        }
+
+        // the rest is for the workers that are waiting
+        if (!queries.empty() && idle > 0) notEmpty.notify_one();
+
+        return !batch.empty();
+    }
+
+    void close()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        closed = true;
+        notEmpty.notify_all();
+    }
+
+private:
+    std::deque<QueuedQuery> queries;
+    size_t idle;            // workers waiting in popBatch
+    bool closed;
+    std::mutex mutex;
+    std::condition_variable notEmpty;
+};
+
+// what a worker needs for its queries
+struct WorkerState
+{
+    std::vector<std::unique_ptr<FlatNetwork> > networks;   // own copy of every graph, made on first use
+    std::vector<char> sourceSide;
+    std::vector<int> cut;
+};
+
+std::vector<std::unique_ptr<ResidentGraph> > graphs;
+QueryQueue queryQueue;
+
+size_t batchSize = 16;
+int listenFd = -1;
+std::atomic<bool> stopping(false);
+
+std::atomic<long long> queriesServed(0);
+std::atomic<long long> solveMicrosTotal(0);
+
+// connections whose reader is still running, so that the shutdown can wake them and wait for them.
+// a reader takes itself out when its connection ends
+std::mutex readersMutex;
+std::condition_variable readersDone;
+std::set<Connection*> liveReaders;
+
+// loads a graph from a file or the generator and adds it to [graphs]
+bool loadGraph(const std::string& arg, unsigned seed);
+
+// accepts connections until the server is stopped
+void acceptConnections();
+
+// reads the requests of one connection and queues them
+void readRequests(std::shared_ptr<Connection> connection);
+
+// takes batches from the queue until it is closed
+void serveQueries();
+
+// answers one request. [out] gets the response followed by the min cut edges, if any
+void answer(const FlowRequest& request, WorkerState& state, SolverWorkspace& ws, std::vector<char>& out);
+
+// stops accepting. safe to call from a signal handler
+void stopServer();
+
+void handleStopSignal(int);
+
+
+int main(int argc, char* argv[])
+{
+
+    std::string socketPath = DEFAULT_FLOW_SOCKET;
+    std::string savePath;
+    int threads = 0;
+    unsigned seed = 1;
+
+    for (int a = 1; a < argc; a++){
+        std::string arg = argv[a];
+
+        if (arg.compare(0, 9, "--socket=") == 0) socketPath = arg.substr(9);
+        else if (arg.compare(0, 10, "--threads=") == 0) threads = atoi(arg.c_str() + 10);
+        else if (arg.compare(0, 8, "--batch=") == 0) batchSize = std::max(1, atoi(arg.c_str() + 8));
+        else if (arg.compare(0, 7, "--seed=") == 0) seed = strtoul(arg.c_str() + 7, NULL, 10);
+        else if (arg.compare(0, 7, "--save=") == 0) savePath = arg.substr(7);
+        else if (arg.compare(0, 8, "--graph=") == 0 || arg.compare(0, 9, "--random=") == 0 || arg.compare(0, 7, "--grid=") == 0){
+            if (!loadGraph(arg, seed)) return 1;
+        }
+        else{
+            std::cout<<"Unknown option "<<arg<<std::endl;
+            std::cout<<"Usage: flowServer [--graph=PATH] [--random=N,M] [--grid=N] [--seed=S] [--save=PATH] [--socket=PATH] [--threads=N] [--batch=N]"<<std::endl;
+            return 1;
+        }
+    }
+
+    if (graphs.empty()){
+        std::cout<<"No graph to serve, give at least one --graph, --random or --grid"<<std::endl;
+        return 1;
+    }
+
+    if (!savePath.empty()){
+        ResidentGraph& last = *graphs.back();
+        bool saved = isBinaryGraphPath(savePath) ? writeBinaryGraph(savePath, last.G, last.s, last.t) : writeDimacsGraph(savePath, last.G, last.s, last.t);
+        if (!saved){
+            std::cout<<"Could not write "<<savePath<<std::endl;
+            return 1;
+        }
+        std::cout<<"Saved graph "<<graphs.size() - 1<<" to "<<savePath<<std::endl;
+    }
+
+    sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+
+    if (socketPath.size() >= sizeof(address.sun_path)){
+        std::cout<<"Socket path "<<socketPath<<" is too long"<<std::endl;
+        return 1;
+    }
+    strcpy(address.sun_path, socketPath.c_str());
+
+    // a socket file left by a server that did not exit cleanly
+    unlink(socketPath.c_str());
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0 || bind(listenFd, (sockaddr*)&address, sizeof(address)) < 0 || listen(listenFd, 64) < 0){
+        std::cout<<"Could not listen on "<<socketPath<<" ("<<strerror(errno)<<")"<<std::endl;
+        return 1;
+    }
+
+    signal(SIGINT, handleStopSignal);
+    signal(SIGTERM, handleStopSignal);
+
+    if (threads <= 0) threads = numberOfCores();
+
+    std::vector<std::thread> workers;
+    for (int k = 0; k < threads; k++){
+        workers.push_back(std::thread(serveQueries));
+    }
+
+    std::cout<<"Serving "<<graphs.size()<<" graph(s) on "<<socketPath<<" with "<<threads<<" worker(s), batches of up to "<<batchSize<<std::endl;
+
+    acceptConnections();
+
+    queryQueue.close();
+    for (size_t k = 0; k < workers.size(); k++){
+        workers[k].join();
+    }
+
+    close(listenFd);
+    unlink(socketPath.c_str());
+
+    long long served = queriesServed;
+    std::cout<<"Served "<<served<<" queries";
+    if (served > 0) std::cout<<", mean solve time "<<(double)solveMicrosTotal / served<<" us";
+    std::cout<<std::endl;
+
+    return 0;
+
+}
+
+bool loadGraph(const std::string& arg, unsigned seed){
+
+    std::unique_ptr<ResidentGraph> graph(new ResidentGraph());
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    if (arg.compare(0, 8, "--graph=") == 0){
+        graph->name = arg.substr(8);
+        if (!readGraphFile(graph->name, graph->G, graph->s, graph->t)) return false;
+    }
+    else if (arg.compare(0, 9, "--random=") == 0){
+        int n, m;
+        if (sscanf(arg.c_str() + 9, "%d,%d", &n, &m) != 2 || n < 2){
+            std::cout<<"Expected --random=N,M"<<std::endl;
+            return false;
+        }
+        graph->name = "random-" + arg.substr(9);
+        generateRandomGraph(graph->G, n, m, seed, graph->s, graph->t);
+    }
+    else{
+        int n = atoi(arg.c_str() + 7);
+        if (n < 2){
+            std::cout<<"Expected --grid=N"<<std::endl;
+            return false;
+        }
+        graph->name = "grid-" + arg.substr(7);
+        generateGridGraph(graph->G, n, seed, graph->s, graph->t);
+    }
+
+    buildFlatNetwork(graph->G, graph->base);
+
+    std::cout<<"Graph "<<graphs.size()<<": "<<graph->name<<", "<<graph->base.n<<" vertices, "<<graph->base.m<<" edges, s = "<<graph->s<<", t = "<<graph->t<<", loaded in ";
+    std::cout<<std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()<<" s"<<std::endl;
+
+    graphs.push_back(std::move(graph));
+
+    return true;
+
+}
+
+void acceptConnections(){
+
+    while (!stopping){
+        int fd = accept(listenFd, NULL, NULL);
+        if (fd < 0){
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            // stopServer shut the listening socket down
+            break;
+        }
+
+        std::shared_ptr<Connection> connection = std::make_shared<Connection>(fd);
+
+        {
+            std::lock_guard<std::mutex> lock(readersMutex);
+            liveReaders.insert(connection.get());
+        }
+
+        // readers are detached so that a finished one gives its stack back at once. a server
+        // with many short connections would otherwise keep all of them until the shutdown
+        try {
+            std::thread(readRequests, connection).detach();
+        }
+        catch (const std::system_error& error){
+            std::cout<<"Could not start a reader, closing the connection ("<<error.what()<<")"<<std::endl;
+            std::lock_guard<std::mutex> lock(readersMutex);
+            liveReaders.erase(connection.get());
+        }
+    }
+
+    // wake the readers that still wait for requests. their queued queries are still answered,
+    // the responses just cannot be read any more by a client that did not ask for the shutdown
+    std::unique_lock<std::mutex> lock(readersMutex);
+    for (std::set<Connection*>::iterator c = liveReaders.begin(); c != liveReaders.end(); c++){
+        shutdown((*c)->fd, SHUT_RD);
+    }
+    readersDone.wait(lock, []{ return liveReaders.empty(); });
+
+}
+
+void readRequests(std::shared_ptr<Connection> connection){
+
+    QueuedQuery query;
+    query.from = connection;
+
+    while (readFully(connection->fd, &query.request, sizeof(FlowRequest))){
+        if (query.request.op != FLOW_OP_SHUTDOWN){
+            queryQueue.push(query);
+            continue;
+        }
+
+        FlowResponse response;
+        memset(&response, 0, sizeof(response));
+        response.id = query.request.id;
+        response.op = FLOW_OP_SHUTDOWN;
+        response.status = FLOW_OK;
+
+        {
+            std::lock_guard<std::mutex> lock(connection->writeMutex);
+            writeFully(connection->fd, &response, sizeof(response));
+        }
+
+        stopServer();
+        break;
+    }
+
+    // leave liveReaders before the connection can be freed, acceptConnections shuts down every
+    // connection in it. the connection stays open while a worker still holds one of its queries
+    std::lock_guard<std::mutex> lock(readersMutex);
+    liveReaders.erase(connection.get());
+    query.from.reset();
+    connection.reset();
+    readersDone.notify_all();
+
+}
+
+void serveQueries(){
+
+    SolverWorkspace& ws = threadWorkspace();
+    WorkerState state;
+    state.networks.resize(graphs.size());
+
+    std::vector<QueuedQuery> batch;
+    std::vector<char> out;
+
+    while (queryQueue.popBatch(batch, batchSize)){
+        // queries on the same graph one after the other
+        std::stable_sort(batch.begin(), batch.end(), [](const QueuedQuery& x, const QueuedQuery& y){ return x.request.graph < y.request.graph; });
+
+        for (size_t k = 0; k < batch.size(); k++){
+            answer(batch[k].request, state, ws, out);
+
+            Connection& to = *batch[k].from;
+            std::lock_guard<std::mutex> lock(to.writeMutex);
+            writeFully(to.fd, out.data(), out.size());
+        }
+
+        // the last reference to a closed connection goes here
+        batch.clear();
+    }
+
+}
+
+void answer(const FlowRequest& request, WorkerState& state, SolverWorkspace& ws, std::vector<char>& out){
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    FlowResponse response;
+    memset(&response, 0, sizeof(response));
+    response.id = request.id;
+    response.op = request.op;
+    response.status = FLOW_OK;
+
+    state.cut.clear();
+
+    if (request.op < FLOW_OP_INFO || request.op > FLOW_OP_CHECK){
+        response.status = FLOW_BAD_OP;
+    }
+    else if (request.graph < 0 || request.graph >= (int)graphs.size()){
+        response.status = FLOW_BAD_GRAPH;
+    }
+    else if (request.op == FLOW_OP_INFO){
+        const ResidentGraph& graph = *graphs[request.graph];
+        response.flow = graph.base.n;
+        response.count = graph.base.m;
+    }
+    else{
+        const ResidentGraph& graph = *graphs[request.graph];
+        int n = graph.base.n;
+        int s = request.s < 0 ? graph.s : request.s;
+        int t = request.s < 0 ? graph.t : request.t;
+
+        if (s >= n || t < 0 || t >= n || s == t){
+            response.status = FLOW_BAD_VERTEX;
+        }
+        else{
+            std::unique_ptr<FlatNetwork>& copy = state.networks[request.graph];
+
+            // the first query makes the copy, later ones only reset its residuals to zero flow
+            if (!copy) copy.reset(new FlatNetwork(graph.base));
+            else std::copy(graph.base.residual.begin(), graph.base.residual.end(), copy->residual.begin());
+
+            FlatNetwork& N = *copy;
+
+            if (flatShortestAugmentedPath(N, s, t, NULL, ws)) response.flow = flatFlowValue(N, s);
+
+            if (request.op == FLOW_OP_CHECK && response.flow != request.value){
+                response.status = FLOW_CHECK_FAILED;
+            }
+
+            if (request.op == FLOW_OP_MIN_CUT){
+                // s side of the cut: what s still reaches in the residual network
+                state.sourceSide.assign(n, 0);
+                ws.queue.clear();
+                ws.queue.push_back(s);
+                state.sourceSide[s] = 1;
+
+                for (size_t q = 0; q < ws.queue.size(); q++){
+                    int v = ws.queue[q];
+                    for (int a = N.first[v]; a < N.first[v + 1]; a++){
+                        int w = N.head[a];
+                        if (state.sourceSide[w] || N.residual[a] <= 0) continue;
+                        state.sourceSide[w] = 1;
+                        ws.queue.push_back(w);
+                    }
+                }
+
+                for (int k = 0; k < N.m; k++){
+                    int a = N.forwardArc[k];
+                    int u = flatArcTail(N, a);
+                    if (state.sourceSide[u] && !state.sourceSide[N.head[a]]){
+                        state.cut.push_back(u);
+                        state.cut.push_back(N.head[a]);
+                    }
+                }
+
+                response.count = state.cut.size() / 2;
+            }
+        }
+    }
+
+    long long micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    response.solveMicros = micros;
+
+    queriesServed++;
+    solveMicrosTotal += micros;
+
+    out.resize(sizeof(response) + state.cut.size() * sizeof(int32_t));
+    memcpy(out.data(), &response, sizeof(response));
+    if (!state.cut.empty()) memcpy(out.data() + sizeof(response), state.cut.data(), state.cut.size() * sizeof(int32_t));
+
+}
+
+void stopServer(){
+
+    stopping = true;
+    // wakes the accept of acceptConnections
+    shutdown(listenFd, SHUT_RDWR);
+
+}
+
+void handleStopSignal(int){
+    stopServer();
+}
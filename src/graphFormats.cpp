@@ -0,0 +1,206 @@
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <unistd.h>
+#include "boostGraphStruct.hpp"
+#include "graphFormats.hpp"
+
+using namespace boost;
+
+const char BINARY_GRAPH_MAGIC[8] = {'A', 'D', 'S', 'T', 'F', 'L', 'W', '1'};
+
+// replaces G with [n] vertices named by their index and the edges of [records], (tail, head, cap)
+// triples numbered from 0
+void buildGraphFromRecords(Graph& G, int n, const std::vector<int>& records);
+
+
+bool readDimacsGraph(const std::string& path, Graph& G, Vertex& s, Vertex& t){
+
+    std::ifstream in(path.c_str());
+    if (!in){
+        std::cout<<"Could not open "<<path<<std::endl;
+        return false;
+    }
+
+    int n = -1, m = -1;
+    int source = -1, sink = -1;
+    std::vector<int> records;
+
+    std::string line;
+    int lineNumber = 0;
+
+    while (std::getline(in, line)){
+        lineNumber++;
+        if (line.empty() || line[0] == 'c') continue;
+
+        bool valid = false;
+
+        if (line[0] == 'p'){
+            char problem[16];
+            valid = n < 0 && sscanf(line.c_str(), "p %15s %d %d", problem, &n, &m) == 3 && strcmp(problem, "max") == 0 && n > 0 && m >= 0;
+            if (valid) records.reserve(3 * (size_t)m);
+        }
+        else if (line[0] == 'n'){
+            int v;
+            char kind;
+            valid = n > 0 && sscanf(line.c_str(), "n %d %c", &v, &kind) == 2 && v >= 1 && v <= n && (kind == 's' || kind == 't');
+            if (valid && kind == 's') source = v - 1;
+            if (valid && kind == 't') sink = v - 1;
+        }
+        else if (line[0] == 'a'){
+            int u, w, cap;
+            valid = n > 0 && sscanf(line.c_str(), "a %d %d %d", &u, &w, &cap) == 3 && u >= 1 && u <= n && w >= 1 && w <= n && cap >= 0;
+            if (valid){
+                records.push_back(u - 1);
+                records.push_back(w - 1);
+                records.push_back(cap);
+            }
+        }
+
+        if (!valid){
+            std::cout<<path<<":"<<lineNumber<<": unexpected line \""<<line<<"\""<<std::endl;
+            return false;
+        }
+    }
+
+    if (n < 0 || source < 0 || sink < 0){
+        std::cout<<path<<": missing the problem line, the source or the sink"<<std::endl;
+        return false;
+    }
+
+    if ((int)records.size() != 3 * m){
+        std::cout<<path<<": the problem line has "<<m<<" arcs but the file has "<<records.size() / 3<<std::endl;
+        return false;
+    }
+
+    buildGraphFromRecords(G, n, records);
+    s = source;
+    t = sink;
+
+    return true;
+
+}
+
+bool readBinaryGraph(const std::string& path, Graph& G, Vertex& s, Vertex& t){
+
+    FILE* in = fopen(path.c_str(), "rb");
+    if (!in){
+        std::cout<<"Could not open "<<path<<std::endl;
+        return false;
+    }
+
+    char magic[8];
+    int header[4] = {0, 0, 0, 0};
+    std::vector<int> records;
+
+    // the records must fill the rest of the file exactly, so that a corrupt m is caught before
+    // the records are allocated
+    long size = -1;
+    if (fseek(in, 0, SEEK_END) == 0) size = ftell(in);
+    rewind(in);
+
+    bool valid = fread(magic, 1, 8, in) == 8 && memcmp(magic, BINARY_GRAPH_MAGIC, 8) == 0 && fread(header, sizeof(int), 4, in) == 4;
+
+    int n = header[0], m = header[1];
+    valid = valid && n > 0 && m >= 0 && header[2] >= 0 && header[2] < n && header[3] >= 0 && header[3] < n;
+    valid = valid && size == (long)(8 + 4 * sizeof(int) + 3 * (size_t)m * sizeof(int));
+
+    // vertices without edges take no records, so n is only bounded by the memory it would need
+    bool fits = (double)n * sizeof(Graph::stored_vertex) <= (double)sysconf(_SC_PHYS_PAGES) * sysconf(_SC_PAGE_SIZE);
+
+    if (valid && fits){
+        records.resize(3 * (size_t)m);
+        valid = fread(records.data(), sizeof(int), records.size(), in) == records.size();
+    }
+
+    fclose(in);
+
+    for (size_t k = 0; valid && k < records.size(); k += 3){
+        valid = records[k] >= 0 && records[k] < n && records[k + 1] >= 0 && records[k + 1] < n && records[k + 2] >= 0;
+    }
+
+    if (!valid){
+        std::cout<<path<<" is not a binary graph file"<<std::endl;
+        return false;
+    }
+
+    if (!fits){
+        std::cout<<path<<" is not a binary graph file, its "<<n<<" vertices do not fit in memory"<<std::endl;
+        return false;
+    }
+
+    buildGraphFromRecords(G, n, records);
+    s = header[2];
+    t = header[3];
+
+    return true;
+
+}
+
+bool writeDimacsGraph(const std::string& path, Graph& G, Vertex s, Vertex t){
+
+    std::ofstream out(path.c_str());
+    if (!out) return false;
+
+    out<<"p max "<<num_vertices(G)<<" "<<num_edges(G)<<"\n";
+    out<<"n "<<s + 1<<" s\n";
+    out<<"n "<<t + 1<<" t\n";
+
+    EdgeIterator e_it, e_it_end;
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+        out<<"a "<<source(*e_it, G) + 1<<" "<<target(*e_it, G) + 1<<" "<<G[*e_it].cap<<"\n";
+    }
+
+    return (bool)out;
+
+}
+
+bool writeBinaryGraph(const std::string& path, Graph& G, Vertex s, Vertex t){
+
+    FILE* out = fopen(path.c_str(), "wb");
+    if (!out) return false;
+
+    int header[4] = {(int)num_vertices(G), (int)num_edges(G), (int)s, (int)t};
+
+    std::vector<int> records;
+    records.reserve(3 * num_edges(G));
+
+    EdgeIterator e_it, e_it_end;
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+        records.push_back(source(*e_it, G));
+        records.push_back(target(*e_it, G));
+        records.push_back(G[*e_it].cap);
+    }
+
+    bool written = fwrite(BINARY_GRAPH_MAGIC, 1, 8, out) == 8 && fwrite(header, sizeof(int), 4, out) == 4 && fwrite(records.data(), sizeof(int), records.size(), out) == records.size();
+
+    return fclose(out) == 0 && written;
+
+}
+
+bool isBinaryGraphPath(const std::string& path){
+    return path.size() > 4 && path.compare(path.size() - 4, 4, ".bin") == 0;
+}
+
+bool readGraphFile(const std::string& path, Graph& G, Vertex& s, Vertex& t){
+    return isBinaryGraphPath(path) ? readBinaryGraph(path, G, s, t) : readDimacsGraph(path, G, s, t);
+}
+
+void buildGraphFromRecords(Graph& G, int n, const std::vector<int>& records){
+
+    G.clear();
+
+    for (int v = 0; v < n; v++){
+        Vertex x = add_vertex(G);
+        G[x].name = std::to_string(v);
+    }
+
+    for (size_t k = 0; k < records.size(); k += 3){
+        Edge e = add_edge(records[k], records[k + 1], G).first;
+        G[e].cap = records[k + 2];
+        G[e].f = 0;
+    }
+
+}
@@ -0,0 +1,348 @@
+#include "boostGraphStruct.hpp"
+#include "graphGenerators.hpp"
+#include <random>
+#include <sstream>
+#include <vector>
+#include <set>
+#include <algorithm>
+
+using namespace boost;
+
+// adds [n] vertices named by their index
+void addNamedVertices(Graph& G, int n);
+
+// returns true if t is reachable from s
+bool generatedPathExists(Graph& G, Vertex s, Vertex t);
+
+// adds the edge u -> w with capacity [cap] and no flow
+void addGeneratedEdge(Graph& G, int u, int w, int cap);
+
+
+void generateRandomGraph(Graph& G, int n, int m, unsigned seed, Vertex& s, Vertex& t){
+
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<int> vertex(0, n - 1);
+    std::uniform_int_distribution<int> capacity(100, 10000);
+
+    // a simple graph has at most n(n-1) edges
+    long long maxEdges = (long long)n * (n - 1);
+    if (m > maxEdges) m = maxEdges;
+
+    do {
+        G.clear();
+        addNamedVertices(G, n);
+
+        std::set<std::pair<int, int> > used;
+
+        while ((int)used.size() < m){
+            int u = vertex(random);
+            int w = vertex(random);
+            if (u == w || !used.insert(std::make_pair(u, w)).second) continue;
+
+            Edge e = add_edge(u, w, G).first;
+            G[e].cap = capacity(random);
+            G[e].f = 0;
+        }
+
+        s = vertex(random);
+        t = vertex(random);
+
+        // sink != source
+        while (t == s){
+            t = vertex(random);
+        }
+
+    } while (!generatedPathExists(G, s, t));
+
+}
+
+void generateGridGraph(Graph& G, int n, unsigned seed, Vertex& s, Vertex& t){
+
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<int> capacity(100, 10000);
+
+    G.clear();
+    addNamedVertices(G, n * n);
+
+    // vertex (i, y) is y * n + i
+
+    for (int y = 0; y < n; y++){
+        for (int i = 0; i < n - 1; i++){
+            Edge e = add_edge(y * n + i, y * n + i + 1, G).first;
+            G[e].cap = capacity(random);
+            G[e].f = 0;
+        }
+    }
+
+    for (int y = 0; y < n - 1; y++){
+        for (int i = 0; i < n; i++){
+            Edge e = add_edge(y * n + i, (y + 1) * n + i, G).first;
+            G[e].cap = capacity(random);
+            G[e].f = 0;
+        }
+    }
+
+    s = 0;
+    t = n * n - 1;
+
+}
+
+void generateBipartiteGraph(Graph& G, int n, int m, unsigned seed, Vertex& s, Vertex& t){
+
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<int> vertex(0, n - 1);
+
+    if (m < 1) m = 1;
+    if ((long long)m > (long long)n * n) m = n * n;
+
+    G.clear();
+    addNamedVertices(G, 2 * n + 2);
+
+    // s is 0, left vertex i is 1 + i, right vertex i is 1 + n + i and t is 2n + 1
+    s = 0;
+    t = 2 * n + 1;
+
+    for (int i = 0; i < n; i++){
+        Edge e = add_edge(s, 1 + i, G).first;
+        G[e].cap = 1;
+        G[e].f = 0;
+
+        e = add_edge(1 + n + i, t, G).first;
+        G[e].cap = 1;
+        G[e].f = 0;
+    }
+
+    std::set<std::pair<int, int> > used;
+
+    while ((int)used.size() < m){
+        int u = vertex(random);
+        int w = vertex(random);
+        if (!used.insert(std::make_pair(u, w)).second) continue;
+
+        Edge e = add_edge(1 + u, 1 + n + w, G).first;
+        G[e].cap = 1;
+        G[e].f = 0;
+    }
+
+}
+
+void generateAKGraph(Graph& G, int k, Vertex& s, Vertex& t){
+
+    if (k < 1) k = 1;
+
+    G.clear();
+    addNamedVertices(G, 4 * k + 2);
+
+    // s is 0 and t is 1. module one is a_i = 2 + i and b_i = 2 + k + i, module two is
+    // c_i = 2 + 2k + i and its dead ends d_i = 2 + 3k + i, for i in 0 .. k-1
+    s = 0;
+    t = 1;
+
+    int a = 2;
+    int b = 2 + k;
+    int c = 2 + 2 * k;
+    int d = 2 + 3 * k;
+
+    // unit i goes s, a_0 .. a_i, b_i .. b_0, t. a_i -> a_i+1 carries the units after i and
+    // b_i -> b_i-1 every unit from i on
+    addGeneratedEdge(G, s, a, k);
+    for (int i = 0; i < k; i++){
+        if (i + 1 < k) addGeneratedEdge(G, a + i, a + i + 1, k - i - 1);
+        addGeneratedEdge(G, a + i, b + i, 1);
+        if (i > 0) addGeneratedEdge(G, b + i, b + i - 1, k - i);
+    }
+    addGeneratedEdge(G, b, t, k);
+
+    addGeneratedEdge(G, s, c, k);
+    for (int i = 0; i < k; i++){
+        addGeneratedEdge(G, c + i, i + 1 < k ? c + i + 1 : t, k);
+        addGeneratedEdge(G, c + i, d + i, k);
+    }
+
+}
+
+void generateGenrmfGraph(Graph& G, int a, int b, int c1, int c2, unsigned seed, Vertex& s, Vertex& t){
+
+    std::mt19937 random(seed);
+
+    if (a < 1) a = 1;
+    if (b < 2) b = 2;
+    if (c1 > c2) std::swap(c1, c2);
+
+    std::uniform_int_distribution<int> capacity(c1, c2);
+
+    int frame = a * a;
+
+    G.clear();
+    addNamedVertices(G, frame * b);
+
+    // vertex (x, y) of frame z is z * a * a + y * a + x
+    int inside = c2 * frame;
+
+    for (int z = 0; z < b; z++){
+        for (int y = 0; y < a; y++){
+            for (int x = 0; x < a; x++){
+                int v = z * frame + y * a + x;
+                if (x + 1 < a){
+                    addGeneratedEdge(G, v, v + 1, inside);
+                    addGeneratedEdge(G, v + 1, v, inside);
+                }
+                if (y + 1 < a){
+                    addGeneratedEdge(G, v, v + a, inside);
+                    addGeneratedEdge(G, v + a, v, inside);
+                }
+            }
+        }
+    }
+
+    std::vector<int> permutation(frame);
+    for (int p = 0; p < frame; p++){
+        permutation[p] = p;
+    }
+
+    for (int z = 0; z + 1 < b; z++){
+        std::shuffle(permutation.begin(), permutation.end(), random);
+        for (int p = 0; p < frame; p++){
+            addGeneratedEdge(G, z * frame + p, (z + 1) * frame + permutation[p], capacity(random));
+        }
+    }
+
+    s = 0;
+    t = frame * b - 1;
+
+}
+
+void generateWashingtonGraph(Graph& G, int rows, int levels, unsigned seed, Vertex& s, Vertex& t){
+
+    const int DEGREE = 3;
+
+    std::mt19937 random(seed);
+    std::uniform_int_distribution<int> capacity(100, 10000);
+
+    if (rows < 1) rows = 1;
+    if (levels < 1) levels = 1;
+
+    std::uniform_int_distribution<int> row(0, rows - 1);
+
+    G.clear();
+    addNamedVertices(G, rows * levels + 2);
+
+    // vertex r of level l is 2 + l * rows + r
+    s = 0;
+    t = 1;
+
+    for (int r = 0; r < rows; r++){
+        addGeneratedEdge(G, s, 2 + r, capacity(random));
+        addGeneratedEdge(G, 2 + (levels - 1) * rows + r, t, capacity(random));
+    }
+
+    std::vector<int> picked;
+
+    for (int l = 0; l + 1 < levels; l++){
+        for (int r = 0; r < rows; r++){
+            picked.clear();
+            while ((int)picked.size() < std::min(DEGREE, rows)){
+                int w = row(random);
+                if (std::find(picked.begin(), picked.end(), w) != picked.end()) continue;
+                picked.push_back(w);
+                addGeneratedEdge(G, 2 + l * rows + r, 2 + (l + 1) * rows + w, capacity(random));
+            }
+        }
+    }
+
+}
+
+void generateRmatGraph(Graph& G, int scale, int edgeFactor, unsigned seed, Vertex& s, Vertex& t){
+
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<double> quadrant(0, 1);
+    std::uniform_int_distribution<int> capacity(100, 10000);
+
+    if (scale < 1) scale = 1;
+    if (edgeFactor < 1) edgeFactor = 1;
+
+    int n = 1 << scale;
+    long long m = (long long)edgeFactor * n;
+
+    G.clear();
+    addNamedVertices(G, n);
+
+    std::set<std::pair<int, int> > used;
+    std::vector<int> degree(n, 0);
+
+    // skewed graphs repeat many edges, so stop after a bounded number of draws
+    for (long long draw = 0; draw < 4 * m && (long long)used.size() < m; draw++){
+        int u = 0;
+        int w = 0;
+
+        for (int bit = scale - 1; bit >= 0; bit--){
+            double p = quadrant(random);
+            if (p < 0.57) continue;
+            if (p < 0.76) w |= 1 << bit;
+            else if (p < 0.95) u |= 1 << bit;
+            else{
+                u |= 1 << bit;
+                w |= 1 << bit;
+            }
+        }
+
+        if (u == w || !used.insert(std::make_pair(u, w)).second) continue;
+
+        addGeneratedEdge(G, u, w, capacity(random));
+        degree[u]++;
+    }
+
+    s = std::max_element(degree.begin(), degree.end()) - degree.begin();
+
+    std::uniform_int_distribution<int> vertex(0, n - 1);
+
+    do {
+        t = vertex(random);
+    } while (t == s || !generatedPathExists(G, s, t));
+
+}
+
+
+void addNamedVertices(Graph& G, int n){
+
+    for (int v = 0; v < n; v++){
+        Vertex x = add_vertex(G);
+        std::stringstream gstream;
+        gstream << v;
+        G[x].name = gstream.str();
+    }
+
+}
+
+bool generatedPathExists(Graph& G, Vertex s, Vertex t){
+
+    OutEdgeIterator out_e_it, out_e_it_end;
+
+    std::vector<bool> visited(num_vertices(G), false);
+    std::vector<Vertex> stack(1, s);
+    visited[s] = true;
+
+    while (!stack.empty()){
+        Vertex v = stack.back();
+        stack.pop_back();
+        if (v == t) return true;
+
+        for (tie(out_e_it, out_e_it_end) = out_edges(v, G); out_e_it != out_e_it_end; out_e_it++){
+            Vertex w = target(*out_e_it, G);
+            if (visited[w]) continue;
+            visited[w] = true;
+            stack.push_back(w);
+        }
+    }
+
+    return false;
+
+}
+
+void addGeneratedEdge(Graph& G, int u, int w, int cap){
+
+    Edge e = add_edge(u, w, G).first;
+    G[e].cap = cap;
+    G[e].f = 0;
+
+}
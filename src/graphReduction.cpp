@@ -0,0 +1,334 @@
+#include "boostGraphStruct.hpp"
+#include "graphReduction.hpp"
+#include <queue>
+#include <map>
+#include <climits>
+#include <algorithm>
+
+using namespace boost;
+
+// arc of the graph while it is being reduced. arcs are never erased, only marked dead
+struct WorkArc
+{
+    Vertex u;
+    Vertex w;
+    int root;
+    bool alive;
+};
+
+// state of the reduction between the original graph and the reduced one
+struct ReductionState
+{
+    std::vector<WorkArc> arcs;
+    std::vector<std::vector<int> > outArcs;
+    std::vector<std::vector<int> > inArcs;
+    std::vector<int> outDeg;
+    std::vector<int> inDeg;
+    std::map<std::pair<Vertex, Vertex>, int> arcBetween;
+    std::vector<ReductionNode>* nodes;
+};
+
+// marks the vertices reachable from [start] using out edges (forward) or in edges (!forward)
+void markReachable(Graph& G, Vertex start, bool forward, std::vector<bool>& reached);
+
+// creates a series or parallel node over [a] and [b]. children of the same kind are
+// spliced in so that long chains do not turn into deep trees
+int combineNodes(std::vector<ReductionNode>& nodes, ReductionNode::Kind kind, int a, int b);
+
+// adds an arc u->w with the tree [root]. merges it with an existing arc u->w if there is one
+void addWorkArc(ReductionState& S, Vertex u, Vertex w, int root);
+
+void killWorkArc(ReductionState& S, int a);
+
+// returns the first alive arc of the list
+int firstAliveArc(ReductionState& S, std::vector<int>& list);
+
+
+void reduceGraph(Graph& G, Vertex s, Vertex t, ReducedGraph& R){
+
+    int n = num_vertices(G);
+
+    EdgeIterator e_it, e_it_end;
+
+    // drop vertices that are unreachable from s or cannot reach t
+
+    std::vector<bool> fromS(n, false);
+    std::vector<bool> toT(n, false);
+
+    markReachable(G, s, true, fromS);
+    markReachable(G, t, false, toT);
+
+    std::vector<bool> keep(n, false);
+    for (int v = 0; v < n; v++){
+        keep[v] = fromS[v] && toT[v];
+    }
+    keep[s] = true;
+    keep[t] = true;
+
+    ReductionState S;
+    S.outArcs.resize(n);
+    S.inArcs.resize(n);
+    S.outDeg.assign(n, 0);
+    S.inDeg.assign(n, 0);
+    S.nodes = &R.nodes;
+
+    R.nodes.clear();
+
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+        Vertex u = source(*e_it, G);
+        Vertex w = target(*e_it, G);
+
+        if (!keep[u] || !keep[w] || G[*e_it].cap <= 0 || u == w) continue;
+
+        ReductionNode leaf;
+        leaf.kind = ReductionNode::LEAF;
+        leaf.cap = G[*e_it].cap;
+        leaf.edge = *e_it;
+        R.nodes.push_back(leaf);
+
+        addWorkArc(S, u, w, R.nodes.size() - 1);
+    }
+
+    // contract degree 2 vertices and drop the ones that became dead ends
+
+    std::vector<Vertex> pending;
+    for (int v = n - 1; v >= 0; v--){
+        if (keep[v]) pending.push_back(v);
+    }
+
+    while (!pending.empty()){
+
+        Vertex v = pending.back();
+        pending.pop_back();
+
+        if (!keep[v] || v == s || v == t) continue;
+
+        if (S.inDeg[v] == 0 || S.outDeg[v] == 0){
+
+            for (size_t k = 0; k < S.outArcs[v].size(); k++){
+                int a = S.outArcs[v][k];
+                if (!S.arcs[a].alive) continue;
+                killWorkArc(S, a);
+                pending.push_back(S.arcs[a].w);
+            }
+            for (size_t k = 0; k < S.inArcs[v].size(); k++){
+                int a = S.inArcs[v][k];
+                if (!S.arcs[a].alive) continue;
+                killWorkArc(S, a);
+                pending.push_back(S.arcs[a].u);
+            }
+            keep[v] = false;
+
+        }
+        else if (S.inDeg[v] == 1 && S.outDeg[v] == 1){
+
+            int in_a = firstAliveArc(S, S.inArcs[v]);
+            int out_a = firstAliveArc(S, S.outArcs[v]);
+
+            Vertex u = S.arcs[in_a].u;
+            Vertex w = S.arcs[out_a].w;
+
+            killWorkArc(S, in_a);
+            killWorkArc(S, out_a);
+            keep[v] = false;
+
+            // u -> v -> u can only carry a cycle, so both arcs are dropped
+            if (u != w){
+                int root = combineNodes(R.nodes, ReductionNode::SERIES, S.arcs[in_a].root, S.arcs[out_a].root);
+                addWorkArc(S, u, w, root);
+            }
+
+            pending.push_back(u);
+            pending.push_back(w);
+
+        }
+    }
+
+    // build the reduced graph
+
+    std::vector<Vertex> newVertex(n, graph_traits<Graph>::null_vertex());
+
+    R.G.clear();
+    R.originalVertex.clear();
+    R.arcs.clear();
+    R.arcRoot.clear();
+
+    for (int v = 0; v < n; v++){
+        if (!keep[v]) continue;
+        Vertex nv = add_vertex(R.G);
+        R.G[nv].name = G[v].name;
+        R.originalVertex.push_back(v);
+        newVertex[v] = nv;
+    }
+
+    R.s = newVertex[s];
+    R.t = newVertex[t];
+
+    for (size_t a = 0; a < S.arcs.size(); a++){
+        if (!S.arcs[a].alive) continue;
+
+        Edge e = add_edge(newVertex[S.arcs[a].u], newVertex[S.arcs[a].w], R.G).first;
+        R.G[e].cap = R.nodes[S.arcs[a].root].cap;
+        R.G[e].f = 0;
+
+        R.arcs.push_back(e);
+        R.arcRoot.push_back(S.arcs[a].root);
+    }
+
+}
+
+void expandReducedFlow(Graph& G, const ReducedGraph& R){
+
+    EdgeIterator e_it, e_it_end;
+
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+        G[*e_it].f = 0;
+    }
+
+    // a series node passes its flow to every child, a parallel node fills its children in order
+
+    std::vector<std::pair<int, int> > stack;
+
+    for (size_t k = 0; k < R.arcs.size(); k++){
+
+        stack.push_back(std::make_pair(R.arcRoot[k], R.G[R.arcs[k]].f));
+
+        while (!stack.empty()){
+
+            int x = stack.back().first;
+            int flow = stack.back().second;
+            stack.pop_back();
+
+            const ReductionNode& node = R.nodes[x];
+
+            if (node.kind == ReductionNode::LEAF){
+                G[node.edge].f = flow;
+            }
+            else if (node.kind == ReductionNode::SERIES){
+                for (size_t c = 0; c < node.children.size(); c++){
+                    stack.push_back(std::make_pair(node.children[c], flow));
+                }
+            }
+            else{
+                int remaining = flow;
+                for (size_t c = 0; c < node.children.size(); c++){
+                    int childFlow = std::min(remaining, R.nodes[node.children[c]].cap);
+                    stack.push_back(std::make_pair(node.children[c], childFlow));
+                    remaining -= childFlow;
+                }
+            }
+        }
+    }
+
+}
+
+
+void markReachable(Graph& G, Vertex start, bool forward, std::vector<bool>& reached){
+
+    OutEdgeIterator out_e_it, out_e_it_end;
+    InEdgeIterator in_e_it, in_e_it_end;
+
+    std::queue<Vertex> Q;
+    Q.push(start);
+    reached[start] = true;
+
+    while (!Q.empty()){
+        Vertex v = Q.front();
+        Q.pop();
+
+        if (forward){
+            for (tie(out_e_it, out_e_it_end) = out_edges(v, G); out_e_it != out_e_it_end; out_e_it++){
+                Vertex w = target(*out_e_it, G);
+                if (G[*out_e_it].cap > 0 && !reached[w]){
+                    reached[w] = true;
+                    Q.push(w);
+                }
+            }
+        }
+        else{
+            for (tie(in_e_it, in_e_it_end) = in_edges(v, G); in_e_it != in_e_it_end; in_e_it++){
+                Vertex w = source(*in_e_it, G);
+                if (G[*in_e_it].cap > 0 && !reached[w]){
+                    reached[w] = true;
+                    Q.push(w);
+                }
+            }
+        }
+    }
+
+}
+
+int combineNodes(std::vector<ReductionNode>& nodes, ReductionNode::Kind kind, int a, int b){
+
+    ReductionNode node;
+    node.kind = kind;
+
+    int parts[2] = {a, b};
+
+    for (int k = 0; k < 2; k++){
+        if (nodes[parts[k]].kind == kind){
+            node.children.insert(node.children.end(), nodes[parts[k]].children.begin(), nodes[parts[k]].children.end());
+        }
+        else{
+            node.children.push_back(parts[k]);
+        }
+    }
+
+    if (kind == ReductionNode::SERIES){
+        node.cap = std::min(nodes[a].cap, nodes[b].cap);
+    }
+    else{
+        long long cap = (long long)nodes[a].cap + nodes[b].cap;
+        node.cap = cap > INT_MAX ? INT_MAX : (int)cap;
+    }
+
+    nodes.push_back(node);
+    return nodes.size() - 1;
+
+}
+
+void addWorkArc(ReductionState& S, Vertex u, Vertex w, int root){
+
+    std::map<std::pair<Vertex, Vertex>, int>::iterator it = S.arcBetween.find(std::make_pair(u, w));
+
+    if (it != S.arcBetween.end()){
+        WorkArc& existing = S.arcs[it->second];
+        existing.root = combineNodes(*S.nodes, ReductionNode::PARALLEL, existing.root, root);
+        return;
+    }
+
+    WorkArc arc;
+    arc.u = u;
+    arc.w = w;
+    arc.root = root;
+    arc.alive = true;
+
+    S.arcs.push_back(arc);
+    int a = S.arcs.size() - 1;
+
+    S.outArcs[u].push_back(a);
+    S.inArcs[w].push_back(a);
+    S.outDeg[u]++;
+    S.inDeg[w]++;
+    S.arcBetween[std::make_pair(u, w)] = a;
+
+}
+
+void killWorkArc(ReductionState& S, int a){
+
+    WorkArc& arc = S.arcs[a];
+    arc.alive = false;
+    S.outDeg[arc.u]--;
+    S.inDeg[arc.w]--;
+    S.arcBetween.erase(std::make_pair(arc.u, arc.w));
+
+}
+
+int firstAliveArc(ReductionState& S, std::vector<int>& list){
+
+    for (size_t k = 0; k < list.size(); k++){
+        if (S.arcs[list[k]].alive) return list[k];
+    }
+    return -1;
+
+}
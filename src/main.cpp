@@ -1,12 +1,44 @@
 #include <iostream>
 #include <string> 
 #include <sstream>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <cstdlib>
+#include <random>
 
 #include "boostGraphStruct.hpp"
 #include "visitor_graph.hpp"
 
 #include "checkMaxFlow.hpp"
 #include "shortestAugmentedPath.hpp"
+#include "benchmarkPipeline.hpp"
+#include "threadTime.hpp"
+#include "graphReduction.hpp"
+#include "vertexReordering.hpp"
+#include "arcOrdering.hpp"
+#include "flatShortestAugmentedPath.hpp"
+#include "arcScan.hpp"
+#include "externalMemorySolver.hpp"
+#include "bipartiteMatching.hpp"
+#include "planarGridFlow.hpp"
+#include "regionMaxFlow.hpp"
+#include "compressedNetwork.hpp"
+#include "solverDispatch.hpp"
+#include "flowCache.hpp"
+#include "edgeFailure.hpp"
+#include "dynamicMaxFlow.hpp"
+#include "traceSpans.hpp"
+#include "graphGenerators.hpp"
+#include "anytimeMaxFlow.hpp"
+#include "asyncSolver.hpp"
+#include "boostBaselines.hpp"
+#include "memoryAccounting.hpp"
+#include "perfCounters.hpp"
+#include "bulkMemory.hpp"
 
 #include <LEDA/graph/graph_alg.h>
 #include <LEDA/graph/templates/max_flow.h> 
@@ -15,6 +47,30 @@
 
 using namespace boost;
 
+// optional stages of the benchmark. set from the command line in main
+struct BenchmarkOptions
+{
+    bool reduceGraph;           // --reduce : run reduceGraph before the solver
+    VertexOrder vertexOrder;    // --reorder=bfs|rcm : relabel the vertices before the solver
+    ArcOrder arcOrder;          // --arc-order=none|distance|capacity|interleave : order the arcs of every vertex for shortestAugmentedPath
+    bool reportArcScan;         // set by --arc-order : print the arcs shortestAugmentedPath scans per advance
+    MaxFlowSolver solver;       // --solver=sap|flat|external|anytime|matching|planar|region|compressed|auto|edmonds-karp|push-relabel|boykov-kolmogorov : the solver compared against MAX_FLOW_T
+    std::string solverName;
+    bool reportMemory;          // --memory : count allocations per phase and print them with the times
+    int gridSize;               // --grid=N : also run the grid evaluation on N x N grids
+    int queries;                // --queries=N : also run N repeated queries with and without the result cache
+    size_t cacheBytes;          // --cache=MB : memory budget of the result cache
+    std::string tracePath;      // --trace=PATH : write the spans of the run as Chrome trace JSON, needs -DADST_TRACE
+    int failures;               // --failures=N : also run the edge failure analysis for N edges
+    int dynamicBatches;         // --dynamic=N : also run N batches of edge changes through DynamicMaxFlow
+    int threads;                // --threads=N : threads of the region solver and of the failure analysis, 0 for one per core
+    std::vector<std::string> hardFamilies;  // --hard=ak|genrmf|washington|rmat : also run the scaling evaluation of a hard instance family
+
+    BenchmarkOptions() : reduceGraph(false), vertexOrder(ORDER_NONE), arcOrder(ARC_ORDER_NONE), reportArcScan(false), solver(shortestAugmentedPath), solverName("shortestAugmentedPath"), reportMemory(false), gridSize(0), queries(0), cacheBytes(64 << 20), failures(0), dynamicBatches(0), threads(0) {}
+};
+
+BenchmarkOptions options;
+
 // prints every graph edge with its flow and capacity
 void printGraphFlow(Graph& G);
 
@@ -24,6 +80,23 @@ void random_graph_evaluation(int num_nodes, int num_edges, int repetitions, bool
 
 void random_grid_graph_evaluation(int num_nodes, int repetitions, bool print_progress = false, bool run_checker = false);
 
+// [family] instances of graphGenerators at three sizes, each twice the one before, so that the
+// times give a scaling curve
+void hard_family_evaluation(const std::string& family, int repetitions, bool print_progress = false, bool run_checker = false);
+
+// [queries] max flow queries over a few terminal pairs of one graph whose capacities change now
+// and then, answered by the solver alone and through a FlowCache
+void repeated_query_evaluation(int num_nodes, int num_edges, int queries);
+
+// max flow of a random graph without each of [failures] random edges, from edgeFailureSensitivity,
+// checked against solving the graph again without the edge for a few of them
+void edge_failure_evaluation(int num_nodes, int num_edges, int failures);
+
+// [batches] batches of capacity changes, edge insertions and deletions on one random graph, each
+// solved by DynamicMaxFlow from the flow before it and checked with CHECK_MAX_FLOW_T and against
+// the solver run from scratch
+void dynamic_flow_evaluation(int num_nodes, int num_edges, int batches);
+
 
 // returns true if there is a path from the source to the target node by calling itself
 // only called by checkNodeConnected
@@ -42,7 +115,9 @@ bool runCheckNodeConnected(leda::graph& LG, leda::node& source_node, leda::node&
 
 // returns true if there is a path from the source node to the target node
 bool checkNodeConnected(leda::graph& LG, leda::node& source_node, leda::node& target_node){
-    
+
+    TRACE_SPAN("checkNodeConnected");
+
     leda::node_array<bool> visited(LG, LG.number_of_nodes(), false);
     
     return runCheckNodeConnected(LG, source_node, target_node, visited);
@@ -55,9 +130,15 @@ bool checkNodeConnected(leda::graph& LG, leda::node& source_node, leda::node& ta
 // the former two are leda nodes mapped to the latter two so that the leda algorithms use
 // the same nodes as the boost ones. That way all algorithms start from the same node
 
-void LEDA_Graph_To_Boost(leda::graph& L_G, leda::edge_array<int>& lcap, leda::edge_array<int>& lf, leda::node& l_source_node, leda::node& l_sink_node, Graph& B_G, Vertex& b_source_node, Vertex& b_sink_node, leda::node_array<std::string>& names)
+// modification: [edge_map] stores the boost edge of every leda edge so that a flow computed
+// on the leda graph after the conversion can still be copied over with copyLEDAFlow
+
+void LEDA_Graph_To_Boost(leda::graph& L_G, leda::edge_array<int>& lcap, leda::edge_array<int>& lf, leda::node& l_source_node, leda::node& l_sink_node, Graph& B_G, Vertex& b_source_node, Vertex& b_sink_node, leda::node_array<std::string>& names, leda::edge_array<Edge>& edge_map)
 {
+    TRACE_SPAN("LEDA_Graph_To_Boost");
+
     leda::node_array<Vertex> Map(L_G);
+    edge_map.init(L_G);
 
     leda::edge e;
     leda::node n;
@@ -76,13 +157,179 @@ void LEDA_Graph_To_Boost(leda::graph& L_G, leda::edge_array<int>& lcap, leda::ed
         Edge u = add_edge(Map[L_G.source(e)], Map[L_G.target(e)], B_G).first;
         B_G[u].cap = lcap[e];
         B_G[u].f = lf[e];
+        edge_map[e] = u;
     }
 }
 
+// copies the flow of the leda graph to the boost graph it was converted to
+void copyLEDAFlow(leda::graph& L_G, leda::edge_array<int>& lf, leda::edge_array<Edge>& edge_map, Graph& B_G)
+{
+    leda::edge e;
+
+    forall_edges(e, L_G)
+    {
+        B_G[edge_map[e]].f = lf[e];
+    }
+}
+
+// a benchmark instance. generated and converted to boost by a producer thread,
+// then solved by the timed consumer in runBenchmark
+struct BenchmarkInstance
+{
+    leda::graph LG;
+    leda::node source_node;
+    leda::node sink_node;
+    leda::edge_array<int> cap;
+    leda::edge_array<int> flow;
+    leda::node_array<std::string> names;
+    leda::edge_array<Edge> edge_map;
+
+    Graph BG;
+    Vertex b_source;
+    Vertex b_sink;
 
-int main()
+    PhaseMemory graphMemory;    // allocations of LEDA_Graph_To_Boost
+};
+
+
+int main(int argc, char* argv[])
 {
 
+    ExternalMemoryOptions external;
+    BulkMemoryPolicy bulk;
+    bool epsilon_set = false;
+
+    for (int a = 1; a < argc; a++){
+        std::string arg = argv[a];
+
+        if (arg == "--reduce") options.reduceGraph = true;
+        else if (arg == "--memory"){
+            options.reportMemory = true;
+            setAllocationCounting(true);
+        }
+        else if (arg == "--perf") setPerfCounters(true);
+        else if (arg == "--reorder=bfs") options.vertexOrder = ORDER_REVERSE_BFS;
+        else if (arg == "--reorder=rcm") options.vertexOrder = ORDER_RCM;
+        else if (arg.compare(0, 12, "--arc-order=") == 0){
+            if (!parseArcOrder(arg.substr(12), options.arcOrder)){
+                std::cout<<"Expected --arc-order=none|distance|capacity|interleave"<<std::endl;
+                return 1;
+            }
+            options.reportArcScan = true;
+            setInterleavedArcScan(options.arcOrder == ARC_ORDER_INTERLEAVE);
+        }
+        else if (arg == "--solver=sap"){
+            options.solver = shortestAugmentedPath;
+            options.solverName = "shortestAugmentedPath";
+        }
+        else if (arg == "--solver=flat"){
+            options.solver = flatShortestAugmentedPath;
+            options.solverName = "flatShortestAugmentedPath";
+        }
+        else if (arg == "--solver=external"){
+            options.solver = externalShortestAugmentedPath;
+            options.solverName = "externalShortestAugmentedPath";
+        }
+        else if (arg == "--solver=anytime"){
+            options.solver = anytimeMaxFlow;
+            options.solverName = "anytimeMaxFlow";
+        }
+        else if (arg == "--solver=matching"){
+            options.solver = bipartiteMaxFlow;
+            options.solverName = "bipartiteMaxFlow";
+        }
+        else if (arg == "--solver=planar"){
+            options.solver = planarGridMaxFlow;
+            options.solverName = "planarGridMaxFlow";
+        }
+        else if (arg == "--solver=region"){
+            options.solver = regionMaxFlow;
+            options.solverName = "regionMaxFlow";
+        }
+        else if (arg == "--solver=compressed"){
+            options.solver = compressedShortestAugmentedPath;
+            options.solverName = "compressedShortestAugmentedPath";
+        }
+        else if (arg.compare(0, 10, "--threads=") == 0){
+            options.threads = atoi(arg.c_str() + 10);
+            setRegionThreads(options.threads);
+        }
+        else if (arg == "--solver=auto"){
+            options.solver = dispatchMaxFlow;
+            options.solverName = "dispatchMaxFlow";
+        }
+        else if (arg.compare(0, 14, "--calibration=") == 0) setCalibrationFile(arg.substr(14));
+        else if (arg == "--solver=edmonds-karp"){
+            options.solver = boostEdmondsKarp;
+            options.solverName = "boostEdmondsKarp";
+        }
+        else if (arg == "--solver=push-relabel"){
+            options.solver = boostPushRelabel;
+            options.solverName = "boostPushRelabel";
+        }
+        else if (arg == "--solver=boykov-kolmogorov"){
+            options.solver = boostBoykovKolmogorov;
+            options.solverName = "boostBoykovKolmogorov";
+        }
+        else if (arg.compare(0, 7, "--grid=") == 0) options.gridSize = atoi(arg.c_str() + 7);
+        else if (arg.compare(0, 10, "--queries=") == 0) options.queries = atoi(arg.c_str() + 10);
+        else if (arg.compare(0, 7, "--hard=") == 0){
+            std::string family = arg.substr(7);
+            if (family != "ak" && family != "genrmf" && family != "washington" && family != "rmat"){
+                std::cout<<"Expected --hard=ak|genrmf|washington|rmat"<<std::endl;
+                return 1;
+            }
+            options.hardFamilies.push_back(family);
+        }
+        else if (arg.compare(0, 11, "--failures=") == 0) options.failures = atoi(arg.c_str() + 11);
+        else if (arg.compare(0, 10, "--dynamic=") == 0) options.dynamicBatches = atoi(arg.c_str() + 10);
+        else if (arg.compare(0, 8, "--cache=") == 0) options.cacheBytes = (size_t)atol(arg.c_str() + 8) << 20;
+        else if (arg.compare(0, 8, "--trace=") == 0){
+            options.tracePath = arg.substr(8);
+            if (!traceCompiledIn()) std::cout<<"Tracing is not compiled in, build with make compile TRACEFLAGS=-DADST_TRACE"<<std::endl;
+        }
+        else if (arg.compare(0, 10, "--epsilon=") == 0){
+            options.solver = anytimeMaxFlow;
+            options.solverName = "anytimeMaxFlow";
+            setAnytimeEpsilon(atof(arg.c_str() + 10));
+            epsilon_set = true;
+        }
+        else if (arg.compare(0, 11, "--deadline=") == 0){
+            options.solver = deadlineMaxFlow;
+            options.solverName = "deadlineMaxFlow";
+            setSolveDeadline(atof(arg.c_str() + 11));
+        }
+        else if (arg.compare(0, 17, "--external-cache=") == 0){
+            external.cacheBytes = (size_t)atol(arg.c_str() + 17) << 20;
+            setExternalMemoryOptions(external);
+        }
+        else if (arg.compare(0, 15, "--external-dir=") == 0){
+            external.directory = arg.substr(15);
+            setExternalMemoryOptions(external);
+        }
+        else if (arg == "--numa=interleave" || arg == "--numa=first-touch"){
+            bulk.placement = arg == "--numa=interleave" ? PLACEMENT_INTERLEAVE : PLACEMENT_FIRST_TOUCH;
+            setBulkMemoryPolicy(bulk);
+        }
+        else if (arg == "--huge-pages=madvise" || arg == "--huge-pages=explicit"){
+            bulk.hugePages = arg == "--huge-pages=madvise" ? HUGE_PAGES_MADVISE : HUGE_PAGES_EXPLICIT;
+            setBulkMemoryPolicy(bulk);
+        }
+        else if (arg == "--scan=scalar") setArcScanKernel(SCAN_SCALAR);
+        else if (arg == "--scan=avx2") setArcScanKernel(SCAN_AVX2);
+        else if (arg == "--scan=avx512") setArcScanKernel(SCAN_AVX512);
+        else{
+            std::cout<<"Unknown option: "<<arg<<std::endl;
+            return 1;
+        }
+    }
+
+    // --epsilon selects anytimeMaxFlow, a later --solver would silently ignore it
+    if (epsilon_set && options.solver != (MaxFlowSolver)anytimeMaxFlow){
+        std::cout<<"--epsilon only applies to --solver=anytime"<<std::endl;
+        return 1;
+    }
+
     // Part 1
     // implement and test
 
@@ -117,6 +364,32 @@ int main()
     // random_grid_graph_evaluation(200, 5, false, false);
     // random_grid_graph_evaluation(300, 2, true, false);
 
+    if (options.gridSize > 1) random_grid_graph_evaluation(options.gridSize, 5, false, false);
+
+    for (size_t f = 0; f < options.hardFamilies.size(); f++){
+        std::cout<<"Hard family evaluation: "<<options.hardFamilies[f]<<std::endl;
+        hard_family_evaluation(options.hardFamilies[f], 3, false, false);
+    }
+
+    if (options.queries > 0){
+        std::cout<<"Repeated query evaluation"<<std::endl;
+        repeated_query_evaluation(4000, 28816, options.queries);
+    }
+
+    if (options.failures > 0){
+        std::cout<<"Edge failure evaluation"<<std::endl;
+        edge_failure_evaluation(4000, 28816, options.failures);
+    }
+
+    if (options.dynamicBatches > 0){
+        std::cout<<"Dynamic max flow evaluation"<<std::endl;
+        dynamic_flow_evaluation(4000, 28816, options.dynamicBatches);
+    }
+
+    if (!options.tracePath.empty() && traceCompiledIn() && !writeTrace(options.tracePath)){
+        std::cout<<"Could not write the trace to "<<options.tracePath<<std::endl;
+    }
+
 
 
 
@@ -141,86 +414,393 @@ void printGraphFlow(Graph& G){
 
 }
 
-void random_graph_evaluation(int num_nodes, int num_edges, int repetitions, bool print_progress, bool run_checker){
+// names the nodes of [LG] with their index so that the boost vertices can be told apart when debugging
+void nameNodes(leda::graph& LG, leda::node_array<std::string>& names){
+
+    TRACE_SPAN("nameNodes");
+
+    leda::node v;
+    int number = 0;
+    names.init(LG, LG.number_of_nodes(), "unnamed");
+    forall_nodes(v, LG){
+        std::stringstream gstream;
+        gstream << number;
+        names[v]=gstream.str();
+        number++;
+    }
+
+}
+
+// gives the edges of [LG] random capacities and a zero flow
+void randomCapacities(leda::graph& LG, leda::edge_array<int>& cap, leda::edge_array<int>& flow){
+
+    TRACE_SPAN("randomCapacities");
+
+    leda::edge e;
+
+    flow.init(LG, LG.number_of_edges(), 0);
+    cap.init(LG, LG.number_of_edges(), 0);
+
+    // give edge capacities random values
+    leda::random_source S; 
+
+    forall_edges(e, LG){
+        cap[e] = S(100, 10000);
+    }
+
+}
+
+void generateRandomInstance(BenchmarkInstance& inst, int num_nodes, int num_edges){
 
     const bool PRINT_DEBUG = false;
     const bool PRINT_SOURCE_AND_SINK = false;
 
-    std::cout<<"Running "<<repetitions<< " repetitions on custom grid graph with "<<num_nodes<<" nodes and "<<num_edges<<" edges\n";
+    TRACE_SPAN("generateRandomInstance");
 
-    float complete_time_L = 0;
-    float complete_time_B = 0;
+    // create random graph with leda
 
-    for (int rep_num = 0; rep_num < repetitions; rep_num++){
+    leda::graph& LG = inst.LG;
 
-        float start_T, finish_T;
+    {
+        TRACE_SPAN("random_simple_loopfree_graph");
+        random_simple_loopfree_graph(LG, num_nodes, num_edges);
+    }
+    {
+        TRACE_SPAN("Make_Connected");
+        Make_Connected(LG);
+    }
 
-        if (print_progress) std::cout<< "\nIteration: "<< rep_num<<"\nCreating Graph\n\n";
+    leda::node source_node = LG.choose_node();
+    leda::node sink_node = LG.choose_node();
 
-        // create random graph with leda
+    // sink != source
+    while (sink_node == source_node){
+        sink_node = LG.choose_node();
+    }
 
-        leda::graph LG;
-        leda::edge e;
-        leda::node v;
+    while(!checkNodeConnected(LG, source_node, sink_node)){
+        TRACE_SPAN("regenerate unconnected instance");
 
         random_simple_loopfree_graph(LG, num_nodes, num_edges);
         Make_Connected(LG);
 
-        leda::node source_node = LG.choose_node();
-        leda::node sink_node = LG.choose_node();
+        source_node = LG.choose_node();
+        sink_node = LG.choose_node();
 
         // sink != source
         while (sink_node == source_node){
             sink_node = LG.choose_node();
         }
 
-        while(!checkNodeConnected(LG, source_node, sink_node)){
-            random_simple_loopfree_graph(LG, num_nodes, num_edges);
-            Make_Connected(LG);
+    }
+
+    if (PRINT_DEBUG || PRINT_SOURCE_AND_SINK){
+        std::cout<<"source: ";
+        LG.print_node(source_node);
+        std::cout<<" sink: ";
+        LG.print_node(sink_node);
+        std::cout<<std::endl;
 
-            source_node = LG.choose_node();
-            sink_node = LG.choose_node();
+    }
 
-            // sink != source
-            while (sink_node == source_node){
-                sink_node = LG.choose_node();
-            }
+    inst.source_node = source_node;
+    inst.sink_node = sink_node;
+
+    randomCapacities(LG, inst.cap, inst.flow);
+    nameNodes(LG, inst.names);
 
+    if (PRINT_DEBUG) LG.print();
+
+    AllocationCounters memory_start;
+    memoryPhaseStart(memory_start);
+
+    LEDA_Graph_To_Boost(LG, inst.cap, inst.flow, inst.source_node, inst.sink_node, inst.BG, inst.b_source, inst.b_sink, inst.names, inst.edge_map);
+
+    inst.graphMemory = memoryPhaseEnd(memory_start);
+
+}
+
+void generateGridInstance(BenchmarkInstance& inst, int num_nodes){
+
+    const bool PRINT_DEBUG = false;
+    const bool PRINT_SOURCE_AND_SINK = false;
+
+    TRACE_SPAN("generateGridInstance");
+
+    // create grid graph with leda
+
+    leda::graph& LG = inst.LG;
+
+    leda::array2< leda::node > nodes_array(num_nodes, num_nodes);
+
+    for (int y = 0; y < num_nodes; y++){
+        for (int i = 0; i < num_nodes; i++){
+            nodes_array(i, y) = LG.new_node();
         }
+    }
 
-        if (PRINT_DEBUG || PRINT_SOURCE_AND_SINK){
-            std::cout<<"source: ";
-            LG.print_node(source_node);
-            std::cout<<" sink: ";
-            LG.print_node(sink_node);
-            std::cout<<std::endl;
+    for (int y = 0; y < num_nodes; y++){
+        for (int i = 0; i < num_nodes-1; i++){
+            LG.new_edge(
+                        nodes_array(i, y),  /*source node*/
+                        nodes_array(i+1, y) /*target node*/
+                        );
+        }
+    }
+
+    for (int y = 0; y < num_nodes-1; y++){
+        for (int i = 0; i < num_nodes; i++){
+            LG.new_edge(
+                        nodes_array(i, y),  /*source node*/
+                        nodes_array(i, y+1) /*target node*/
+                        );
+        }
+    }
+
+    inst.source_node = nodes_array(0, 0);
+    inst.sink_node = nodes_array(num_nodes-1, num_nodes-1);
+
+    if (PRINT_DEBUG || PRINT_SOURCE_AND_SINK){
+        std::cout<<"source: ";
+        LG.print_node(inst.source_node);
+        std::cout<<" sink: ";
+        LG.print_node(inst.sink_node);
+        std::cout<<std::endl;
+
+    }
+
+    randomCapacities(LG, inst.cap, inst.flow);
+    nameNodes(LG, inst.names);
+
+    if (PRINT_DEBUG) LG.print();
+
+    AllocationCounters memory_start;
+    memoryPhaseStart(memory_start);
+
+    LEDA_Graph_To_Boost(LG, inst.cap, inst.flow, inst.source_node, inst.sink_node, inst.BG, inst.b_source, inst.b_sink, inst.names, inst.edge_map);
+
+    inst.graphMemory = memoryPhaseEnd(memory_start);
+
+}
+
+// one instance of a graphGenerators family. the generated Boost graph is copied into LG with its
+// capacities, so that the instance goes through MAX_FLOW_T and LEDA_Graph_To_Boost like the others
+void generateFamilyInstance(BenchmarkInstance& inst, const std::string& family, int size, unsigned seed){
+
+    // capacity range of the edges between GENRMF frames, and the R-MAT edges per vertex
+    const int GENRMF_MIN_CAP = 1;
+    const int GENRMF_MAX_CAP = 10000;
+    const int RMAT_EDGE_FACTOR = 8;
+
+    TRACE_SPAN("generateFamilyInstance");
+
+    Graph G;
+    Vertex s, t;
+
+    // [size] is k for ak, the frame side for genrmf (twice as many frames), the level width and
+    // count for washington and the scale for rmat
+    if (family == "ak") generateAKGraph(G, size, s, t);
+    else if (family == "genrmf") generateGenrmfGraph(G, size, 2 * size, GENRMF_MIN_CAP, GENRMF_MAX_CAP, seed, s, t);
+    else if (family == "washington") generateWashingtonGraph(G, size, size, seed, s, t);
+    else generateRmatGraph(G, size, RMAT_EDGE_FACTOR, seed, s, t);
+
+    leda::graph& LG = inst.LG;
+
+    std::vector<leda::node> nodes(num_vertices(G));
+    for (size_t v = 0; v < nodes.size(); v++){
+        nodes[v] = LG.new_node();
+    }
+
+    // LEDA keeps the edges in the order they were made, so the capacities can be matched by position
+    std::vector<int> caps;
+    EdgeIterator e_it, e_it_end;
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+        LG.new_edge(nodes[source(*e_it, G)], nodes[target(*e_it, G)]);
+        caps.push_back(G[*e_it].cap);
+    }
+
+    inst.flow.init(LG, LG.number_of_edges(), 0);
+    inst.cap.init(LG, LG.number_of_edges(), 0);
+
+    leda::edge e;
+    int k = 0;
+    forall_edges(e, LG){
+        inst.cap[e] = caps[k++];
+    }
+
+    inst.source_node = nodes[s];
+    inst.sink_node = nodes[t];
+
+    nameNodes(LG, inst.names);
+
+    AllocationCounters memory_start;
+    memoryPhaseStart(memory_start);
+
+    LEDA_Graph_To_Boost(LG, inst.cap, inst.flow, inst.source_node, inst.sink_node, inst.BG, inst.b_source, inst.b_sink, inst.names, inst.edge_map);
+
+    inst.graphMemory = memoryPhaseEnd(memory_start);
+
+}
+
+// runs the selected solver on BG through the pre-solve stages selected in options and
+// returns the time of the solver alone. the stages and the flow expansion are added to [stage_T]
+// and the allocations and hardware counters of the solver alone are stored in [solve_memory] and
+// [solve_counters]. the arcs shortestAugmentedPath scanned and its advances are stored in [scan],
+// they are 0 for other solvers
+float solveWithStages(Graph& BG, Vertex b_source, Vertex b_sink, bool print_progress, float& stage_T, PhaseMemory& solve_memory, PerfSample& solve_counters, SapPhaseTimes& scan){
+
+    float start_T, solve_T;
+
+    Graph* G = &BG;
+    Vertex s = b_source;
+    Vertex t = b_sink;
+
+    ReducedGraph R;
+    ReorderedGraph O;
+
+    if (options.reduceGraph){
+        TRACE_SPAN("reduceGraph");
+        start_T = threadTime();
+        reduceGraph(*G, s, t, R);
+        stage_T += threadTime(start_T);
+
+        if (print_progress) std::cout<< "Reduced graph to "<< num_vertices(R.G)<< " nodes and "<< num_edges(R.G)<< " edges\n\n";
+
+        G = &R.G;
+        s = R.s;
+        t = R.t;
+    }
+
+    if (options.vertexOrder != ORDER_NONE){
+        TRACE_SPAN("reorderVertices");
+        start_T = threadTime();
+        reorderVertices(*G, s, t, options.vertexOrder, O);
+        stage_T += threadTime(start_T);
+
+        G = &O.G;
+        s = O.s;
+        t = O.t;
+    }
+
+    // the lists are sorted in place, so there is no flow to expand afterwards
+    if (options.arcOrder == ARC_ORDER_DISTANCE || options.arcOrder == ARC_ORDER_CAPACITY){
+        TRACE_SPAN("orderArcs");
+        start_T = threadTime();
+        orderArcs(*G, t, options.arcOrder);
+        stage_T += threadTime(start_T);
+    }
+
+    AllocationCounters memory_start;
+    memoryPhaseStart(memory_start);
+
+    PerfReading counters_start;
+    perfPhaseStart(counters_start);
+
+    scan.arcsScanned = 0;
+    scan.advances = 0;
+    scan.advanceArcs = 0;
+
+    {
+        TRACE_SPAN(options.solverName.c_str());
+        start_T = threadTime();
 
+        // the phase times of SAP also count the arcs it scans, which the counters are divided by
+        if (options.solver == (MaxFlowSolver)shortestAugmentedPath && (perfCountersEnabled() || options.reportArcScan)){
+            shortestAugmentedPath(*G, s, t, &scan);
         }
+        else options.solver(*G, s, t);
+
+        solve_T = threadTime(start_T);
+    }
+
+    solve_counters = perfPhaseEnd(counters_start);
+    solve_memory = memoryPhaseEnd(memory_start);
+
+    // expand the flow back through the stages in reverse order
+
+    TRACE_SPAN("expand flow");
+
+    start_T = threadTime();
+    if (options.vertexOrder != ORDER_NONE) expandReorderedFlow(options.reduceGraph ? R.G : BG, O);
+    if (options.reduceGraph) expandReducedFlow(BG, R);
+    stage_T += threadTime(start_T);
+
+    return solve_T;
+
+}
+
+// producer/consumer benchmark. one background thread generates and converts instances into
+// a bounded queue while the calling thread, pinned to its own core, only runs the timed
+// solvers and the checker. LEDA's generators share their random state and its memory
+// manager is not thread safe, so every LEDA call of either thread (generation, MAX_FLOW_T,
+// copying the flow and destroying an instance) holds leda_mutex. the producer can still
+// build the next instance while the boost solvers and the checker run, and with a single
+// producer the instances come in the same order on every run
+void runBenchmark(std::function<void(BenchmarkInstance&)> generate, int repetitions, bool print_progress, bool run_checker){
 
-        leda::edge_array<int> flow(LG, LG.number_of_edges(), 0);
-        leda::edge_array<int> cap(LG, LG.number_of_edges(), 0);
+    const bool PRINT_DEBUG = false;
+    const int QUEUE_CAPACITY = 2;
 
-        // give edge capacities random values
-        leda::random_source S; 
+    const int cores = numberOfCores();
+    const int TIMED_CORE = cores - 1;
 
-        forall_edges(e, LG){
-            cap[e] = S(100, 10000);
+    float complete_time_L = 0;
+    float complete_time_B = 0;
+    float complete_time_S = 0;
+
+    // arcs shortestAugmentedPath scanned in all repetitions, with --arc-order
+    long long total_scanned = 0;
+    long long total_advances = 0;
+    long long total_advance_arcs = 0;
+
+    // largest graph, solver and checker allocations of all repetitions
+    PhaseMemory max_memory_G = {0, 0, 0};
+    PhaseMemory max_memory_B = {0, 0, 0};
+    PhaseMemory max_memory_C = {0, 0, 0};
+
+    // peak RSS of the process during each solve, if the peak can be reset
+    long max_solve_rss = -1;
+    bool rss_resettable = true;
+
+    BoundedQueue<std::unique_ptr<BenchmarkInstance> > instances(QUEUE_CAPACITY);
+    std::mutex leda_mutex;
+
+    std::thread producer([&]{
+        TRACE_THREAD_NAME("producer");
+        pinThreadAwayFromCore(TIMED_CORE);
+        for (int rep = 0; rep < repetitions; rep++){
+            std::unique_ptr<BenchmarkInstance> inst;
+            {
+                std::lock_guard<std::mutex> lock(leda_mutex);
+                inst.reset(new BenchmarkInstance);
+                generate(*inst);
+            }
+            TRACE_SPAN("queue push");
+            instances.push(std::move(inst));
         }
+    });
+
+    TRACE_THREAD_NAME("timed");
+    cpu_set_t caller_affinity = threadAffinity();
+    pinThreadToCore(TIMED_CORE);
 
-        // name nodes
+    for (int rep_num = 0; rep_num < repetitions; rep_num++){
 
-        int number = 0;
-        leda::node_array<std::string> names(LG, LG.number_of_nodes(), "unnamed");
-        forall_nodes(v, LG){
-            std::stringstream gstream;
-            gstream << number;
-            names[v]=gstream.str();
-            number++;
+        TRACE_SPAN("repetition");
+
+        float start_T, finish_T;
+
+        std::unique_ptr<BenchmarkInstance> inst;
+        {
+            TRACE_SPAN("queue pop");
+            inst = instances.pop();
         }
 
-        if (PRINT_DEBUG) LG.print();
+        if (print_progress) std::cout<< "\nIteration: "<< rep_num<<"\n\n";
+
         if (PRINT_DEBUG){
-            if (checkNodeConnected(LG, source_node, sink_node)){
+            std::lock_guard<std::mutex> lock(leda_mutex);
+            if (checkNodeConnected(inst->LG, inst->source_node, inst->sink_node)){
                 std::cout<<"source and sink are connected"<<std::endl;
             }
             else{
@@ -229,22 +809,37 @@ void random_graph_evaluation(int num_nodes, int num_edges, int repetitions, bool
 
         }
 
-
         if (print_progress) std::cout<< "Running MAX_FLOW_T\n\n";
 
-        start_T = leda::used_time();
-        MAX_FLOW_T(LG, source_node, sink_node, cap, flow);
-        finish_T = leda::used_time(start_T);
+        PerfReading counters_start;
+        PerfSample leda_counters;
+
+        {
+            // taken before the clock starts. threadTime is cpu time, so the wait would not
+            // count anyway
+            std::lock_guard<std::mutex> lock(leda_mutex);
+            TRACE_SPAN("MAX_FLOW_T");
+            perfPhaseStart(counters_start);
+            start_T = threadTime();
+            MAX_FLOW_T(inst->LG, inst->source_node, inst->sink_node, inst->cap, inst->flow);
+            finish_T = threadTime(start_T);
+            leda_counters = perfPhaseEnd(counters_start);
+        }
 
         complete_time_L += finish_T;
         
         if (print_progress) std::cout<< "MAX_FLOW_T finished with time: "<< finish_T<<" seconds\n\n";
 
-        Graph BG;
-
-        Vertex b_source, b_sink;
+        Graph& BG = inst->BG;
+        Vertex b_source = inst->b_source;
+        Vertex b_sink = inst->b_sink;
 
-        LEDA_Graph_To_Boost(LG, cap, flow, source_node, sink_node, BG, b_source, b_sink, names);
+        // the instance was converted before MAX_FLOW_T ran so its flow has to be copied over
+        if (run_checker || PRINT_DEBUG){
+            std::lock_guard<std::mutex> lock(leda_mutex);
+            TRACE_SPAN("copyLEDAFlow");
+            copyLEDAFlow(inst->LG, inst->flow, inst->edge_map, BG);
+        }
 
         if (PRINT_DEBUG) printGraphFlow(BG);
 
@@ -258,20 +853,57 @@ void random_graph_evaluation(int num_nodes, int num_edges, int repetitions, bool
             }
         }
 
-        if (print_progress) std::cout<<"Running shortestAugmentedPath\n\n";
+        if (print_progress) std::cout<<"Running "<<options.solverName<<"\n\n";
+
+        PhaseMemory solve_memory;
+        PerfSample solve_counters;
+        SapPhaseTimes scan;
+
+        // the peak is of the whole process, so it also holds the instance the producer builds
+        // in the meantime
+        bool rss_reset = options.reportMemory && resetPeakRSS();
 
-        start_T = leda::used_time();
-        shortestAugmentedPath(BG, b_source, b_sink);
-        finish_T = leda::used_time(start_T);
+        finish_T = solveWithStages(BG, b_source, b_sink, print_progress, complete_time_S, solve_memory, solve_counters, scan);
+
+        long solve_rss = rss_reset ? peakRSSSinceResetKilobytes() : -1;
+
+        total_scanned += scan.arcsScanned;
+        total_advances += scan.advances;
+        total_advance_arcs += scan.advanceArcs;
 
         complete_time_B += finish_T;
 
-        if (print_progress) std::cout<< "shortestAugmentedPath finished with time: "<< finish_T<<" seconds\n\n";
+        if (print_progress) std::cout<< options.solverName<< " finished with time: "<< finish_T<<" seconds\n\n";
+
+        // the sweeps ran on several threads, so the time above is only the calling thread's
+        if (options.solver == (MaxFlowSolver)regionMaxFlow){
+            RegionSolveStats region = regionSolveStats();
+            std::cout<< "regionMaxFlow: "<< region.regions<< " regions on "<< region.threads<< " threads, "<< region.sweeps<< " sweeps, ";
+            std::cout<< region.boundaryPushes<< " of "<< region.pushes<< " pushes over region boundaries, "<< region.seconds<< " seconds wall clock\n\n";
+        }
+
+        // the solve ran on a worker thread, so the time above is the waiting thread's
+        if (options.solver == (MaxFlowSolver)deadlineMaxFlow){
+            AsyncSolveStats async = asyncSolveStats();
+            const char* status[] = {"done", "t unreachable", "cancelled", "deadline passed"};
+            std::cout<< "deadlineMaxFlow: "<< status[async.status]<< ", flow "<< async.flow<< ", worker cpu time "<< async.cpuTime<< " seconds, progress read "<< async.polls<< " times\n\n";
+        }
 
         if (PRINT_DEBUG) printGraphFlow(BG);
 
+        PhaseMemory checker_memory = {0, 0, 0};
+        PerfSample checker_counters;
+
         if (run_checker){
+            AllocationCounters memory_start;
+            memoryPhaseStart(memory_start);
+            perfPhaseStart(counters_start);
+
             bool res = CHECK_MAX_FLOW_T(BG, b_source, b_sink, false);
+
+            checker_counters = perfPhaseEnd(counters_start);
+            checker_memory = memoryPhaseEnd(memory_start);
+
             if (res){
                 std::cout<<"Graph has max flow"<<std::endl;
             }
@@ -280,169 +912,356 @@ void random_graph_evaluation(int num_nodes, int num_edges, int repetitions, bool
             }
         }
 
+        // without access to the counters only the times are reported
+        if (perfCountersAvailable()){
+            std::cout<< "Counters of MAX_FLOW_T: "<< perfSummary(leda_counters, 0)<< "\n";
+            std::cout<< "Counters of "<< options.solverName<< ": "<< perfSummary(solve_counters, scan.arcsScanned)<< "\n";
+            if (run_checker) std::cout<< "Counters of CHECK_MAX_FLOW_T: "<< perfSummary(checker_counters, 0)<< "\n";
+            std::cout<<std::endl;
+        }
+
+        if (options.reportMemory){
+            if (print_progress){
+                std::cout<< "Boost graph: "<< inst->graphMemory.bytes<< " bytes in "<< inst->graphMemory.allocations<< " allocations\n";
+                std::cout<< options.solverName<< ": peak "<< solve_memory.peakBytes<< " bytes, "<< solve_memory.bytes<< " bytes in "<< solve_memory.allocations<< " allocations\n";
+                if (solve_rss >= 0) std::cout<< "Peak RSS during "<< options.solverName<< ": "<< solve_rss<< " kB\n";
+                if (run_checker) std::cout<< "CHECK_MAX_FLOW_T: peak "<< checker_memory.peakBytes<< " bytes, "<< checker_memory.bytes<< " bytes in "<< checker_memory.allocations<< " allocations\n";
+                std::cout<<std::endl;
+            }
+
+            max_memory_G.bytes = std::max(max_memory_G.bytes, inst->graphMemory.bytes);
+            max_memory_G.allocations = std::max(max_memory_G.allocations, inst->graphMemory.allocations);
+            max_memory_B.peakBytes = std::max(max_memory_B.peakBytes, solve_memory.peakBytes);
+            max_memory_B.allocations = std::max(max_memory_B.allocations, solve_memory.allocations);
+            max_memory_C.peakBytes = std::max(max_memory_C.peakBytes, checker_memory.peakBytes);
+            max_memory_C.allocations = std::max(max_memory_C.allocations, checker_memory.allocations);
+            max_solve_rss = std::max(max_solve_rss, solve_rss);
+            rss_resettable = rss_resettable && rss_reset;
+        }
+
+        // the LEDA graph and arrays of the instance are freed while the producer may be generating
+        {
+            std::lock_guard<std::mutex> lock(leda_mutex);
+            inst.reset();
+        }
+
     }
 
+    producer.join();
+    restoreThreadAffinity(caller_affinity);
+
     float avrg_L = complete_time_L / repetitions;
     float avrg_B = complete_time_B / repetitions;
 
     std::cout<< repetitions<< " repetitions of LEDA MAX_FLOW_T took total "<< complete_time_L<< " seconds with average time "<< avrg_L<<" seconds\n\n";
-    std::cout<< repetitions<< " repetitions of shortestAugmentedPath took total "<< complete_time_B<< " seconds with average time "<< avrg_B<<" seconds\n\n";
+    std::cout<< repetitions<< " repetitions of "<< options.solverName<< " took total "<< complete_time_B<< " seconds with average time "<< avrg_B<<" seconds\n\n";
+
+    if (options.reduceGraph || options.vertexOrder != ORDER_NONE || options.arcOrder != ARC_ORDER_NONE){
+        std::cout<< repetitions<< " repetitions of the pre-solve stages took total "<< complete_time_S<< " seconds with average time "<< complete_time_S / repetitions<<" seconds\n\n";
+    }
+
+    if (options.reportArcScan && total_advances > 0){
+        std::cout<< "Arc order "<< arcOrderName(options.arcOrder)<< ": "<< (double)total_advance_arcs / total_advances<< " arcs scanned per advance over "<< total_advances<< " advances, "<< total_scanned<< " arcs scanned in total\n\n";
+    }
+
+    if (bulkMemoryPolicy().placement != PLACEMENT_DEFAULT || bulkMemoryPolicy().hugePages != HUGE_PAGES_NONE){
+        BulkMemoryStats bulk = bulkMemoryStats();
+        std::cout<< "Bulk arrays: "<< bulk.mappedBytes<< " bytes mapped, "<< bulk.explicitHugeBytes<< " in explicit huge pages, "<< bulk.interleavedBytes<< " interleaved over "<< numaNodes()<< " nodes, "<< bulk.firstTouchBytes<< " placed by first touch, "<< bulk.fallbacks<< " fallbacks\n\n";
+    }
+
+    if (options.reportMemory){
+        std::cout<< "Largest Boost graph: "<< max_memory_G.bytes<< " bytes in "<< max_memory_G.allocations<< " allocations\n";
+        std::cout<< "Largest "<< options.solverName<< " peak: "<< max_memory_B.peakBytes<< " bytes, up to "<< max_memory_B.allocations<< " allocations per solve\n";
+        if (run_checker) std::cout<< "Largest CHECK_MAX_FLOW_T peak: "<< max_memory_C.peakBytes<< " bytes, up to "<< max_memory_C.allocations<< " allocations per check\n";
+        if (rss_resettable && max_solve_rss >= 0) std::cout<< "Largest peak RSS during "<< options.solverName<< ": "<< max_solve_rss<< " kB\n\n";
+        else std::cout<< "The peak RSS cannot be reset here (/proc/self/clear_refs), peak RSS of the whole run so far: "<< peakRSSKilobytes()<< " kB\n\n";
+    }
+
+}
+
+void random_graph_evaluation(int num_nodes, int num_edges, int repetitions, bool print_progress, bool run_checker){
+
+    std::cout<<"Running "<<repetitions<< " repetitions on custom grid graph with "<<num_nodes<<" nodes and "<<num_edges<<" edges\n";
+
+    runBenchmark([=](BenchmarkInstance& inst){ generateRandomInstance(inst, num_nodes, num_edges); }, repetitions, print_progress, run_checker);
 
 }
 
 void random_grid_graph_evaluation(int num_nodes, int repetitions, bool print_progress, bool run_checker){
-    
-    const bool PRINT_DEBUG = false;
-    const bool PRINT_SOURCE_AND_SINK = false;
 
     std::cout<<"Running "<<repetitions<< " repetitions on random graphs with "<<num_nodes<<" nodes\n";
 
-    float complete_time_L = 0;
-    float complete_time_B = 0;
+    runBenchmark([=](BenchmarkInstance& inst){ generateGridInstance(inst, num_nodes); }, repetitions, print_progress, run_checker);
 
-    for (int rep_num = 0; rep_num < repetitions; rep_num++){
+}
 
-        float start_T, finish_T;
+void hard_family_evaluation(const std::string& family, int repetitions, bool print_progress, bool run_checker){
 
-        if (print_progress) std::cout<< "\nIteration: "<< rep_num<<"\nCreating Graph\n\n";
+    int size;
+    if (family == "ak") size = 512;
+    else if (family == "genrmf") size = 8;
+    else if (family == "washington") size = 32;
+    else size = 9;  // R-MAT hubs make shortestAugmentedPath seconds per solve from scale 11 on
 
-        // create random graph with leda
+    for (int step = 0; step < 3; step++){
 
-        leda::graph LG;
-        leda::edge e;
-        leda::node v;
+        std::cout<<"Running "<<repetitions<<" repetitions on "<<family<<" graphs of size "<<size<<"\n";
 
-        leda::array2< leda::node > nodes_array(num_nodes, num_nodes);
+        // instances are made by the producer thread, every one gets its own seed
+        std::shared_ptr<std::atomic<unsigned> > seed(new std::atomic<unsigned>(1));
 
-        for (int y = 0; y < num_nodes; y++){
-            for (int i = 0; i < num_nodes; i++){
-                nodes_array(i, y) = LG.new_node();
-            }
-        }
+        runBenchmark([=](BenchmarkInstance& inst){ generateFamilyInstance(inst, family, size, (*seed)++); }, repetitions, print_progress, run_checker);
+
+        // twice the vertices: rmat is sized by its scale, genrmf has 2 size^3 and washington size^2
+        if (family == "ak") size *= 2;
+        else if (family == "rmat") size += 1;
+        else if (family == "genrmf") size = (int)(size * 1.26 + 0.5);
+        else size = (int)(size * 1.41 + 0.5);
+    }
 
-        for (int y = 0; y < num_nodes; y++){
-            for (int i = 0; i < num_nodes-1; i++){
-                LG.new_edge(
-                            nodes_array(i, y),  /*source node*/
-                            nodes_array(i+1, y) /*target node*/
-                            );
+}
+
+void repeated_query_evaluation(int num_nodes, int num_edges, int queries){
+
+    // terminal pairs asked about, and queries between two capacity changes
+    const int PAIRS = 8;
+    const int QUERIES_PER_CHANGE = 50;
+
+    std::cout<<"Running "<<queries<<" queries over "<<PAIRS<<" terminal pairs on a random graph with "<<num_nodes<<" nodes and "<<num_edges<<" edges, "<<options.cacheBytes<<" bytes of cache\n";
+
+    Graph G;
+    Vertex s, t;
+    generateRandomGraph(G, num_nodes, num_edges, 1, s, t);
+
+    std::vector<Edge> edgeList;
+    EdgeIterator e_it, e_it_end;
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+        edgeList.push_back(*e_it);
+    }
+
+    std::mt19937 random(1);
+    std::uniform_int_distribution<int> vertex(0, num_nodes - 1);
+    std::uniform_int_distribution<int> edge(0, edgeList.size() - 1);
+    std::uniform_int_distribution<int> capacity(100, 10000);
+    std::uniform_int_distribution<int> pair(0, PAIRS - 1);
+
+    std::vector<std::pair<Vertex, Vertex> > pairs(1, std::make_pair(s, t));
+    while ((int)pairs.size() < PAIRS){
+        pairs.push_back(std::make_pair(vertex(random), vertex(random)));
+        if (pairs.back().first == pairs.back().second) pairs.pop_back();
+    }
+
+    // the same queries and changes twice, so that both runs see the same graphs
+    std::vector<long long> values[2];
+    float solver_T = 0;
+    float cache_T = 0;
+    long long hits = 0, misses = 0, evictions = 0;
+
+    for (int run = 0; run < 2; run++){
+        bool cached = run == 1;
+        GraphFingerprint fingerprint(G);
+        FlowCache cache(options.cacheBytes, false);
+        std::vector<std::pair<Edge, int> > changed;
+
+        random.seed(2);
+        float start_T = threadTime();
+
+        for (int q = 0; q < queries; q++){
+            if (q > 0 && q % QUERIES_PER_CHANGE == 0){
+                Edge e = edgeList[edge(random)];
+                changed.push_back(std::make_pair(e, G[e].cap));
+                fingerprint.setCapacity(e, capacity(random));
             }
-        }
 
-        for (int y = 0; y < num_nodes-1; y++){
-            for (int i = 0; i < num_nodes; i++){
-                LG.new_edge(
-                            nodes_array(i, y),  /*source node*/
-                            nodes_array(i, y+1) /*target node*/
-                            );
+            std::pair<Vertex, Vertex> st = pairs[pair(random)];
+
+            if (cached) values[run].push_back(cachedMaxFlow(G, st.first, st.second, fingerprint, cache, options.solver, false));
+            else{
+                long long flow = 0;
+                if (options.solver(G, st.first, st.second)){
+                    OutEdgeIterator out_e_it, out_e_it_end;
+                    InEdgeIterator in_e_it, in_e_it_end;
+                    for (tie(out_e_it, out_e_it_end) = out_edges(st.first, G); out_e_it != out_e_it_end; out_e_it++) flow += G[*out_e_it].f;
+                    for (tie(in_e_it, in_e_it_end) = in_edges(st.first, G); in_e_it != in_e_it_end; in_e_it++) flow -= G[*in_e_it].f;
+                }
+                values[run].push_back(flow);
             }
         }
 
-        leda::node source_node = nodes_array(0, 0);
-        leda::node sink_node = nodes_array(num_nodes-1, num_nodes-1);
+        (cached ? cache_T : solver_T) = threadTime(start_T);
 
-        if (PRINT_DEBUG || PRINT_SOURCE_AND_SINK){
-            std::cout<<"source: ";
-            LG.print_node(source_node);
-            std::cout<<" sink: ";
-            LG.print_node(sink_node);
-            std::cout<<std::endl;
+        hits = cache.hits;
+        misses = cache.misses;
+        evictions = cache.evictions;
 
+        // back to the starting capacities for the next run
+        for (int k = changed.size() - 1; k >= 0; k--){
+            G[changed[k].first].cap = changed[k].second;
         }
+    }
+
+    std::cout<<options.solverName<<" alone took "<<solver_T<<" seconds, with the cache "<<cache_T<<" seconds\n";
+    std::cout<<hits<<" hits, "<<misses<<" misses, "<<evictions<<" evictions\n";
+    if (values[0] != values[1]) std::cout<<"Cached flow values differ from the solver\n";
+    std::cout<<std::endl;
 
-        leda::edge_array<int> flow(LG, LG.number_of_edges(), 0);
-        leda::edge_array<int> cap(LG, LG.number_of_edges(), 0);
+}
 
-        // give edge capacities random values
-        leda::random_source S; 
+void edge_failure_evaluation(int num_nodes, int num_edges, int failures){
 
-        forall_edges(e, LG){
-            cap[e] = S(100, 10000);
-        }
+    // failures checked by solving the graph again, the others are only timed together
+    const int CHECKED = 20;
 
-        // name nodes
+    Graph G;
+    Vertex s, t;
+    generateRandomGraph(G, num_nodes, num_edges, 1, s, t);
 
-        int number = 0;
-        leda::node_array<std::string> names(LG, LG.number_of_nodes(), "unnamed");
-        forall_nodes(v, LG){
-            std::stringstream gstream;
-            gstream << number;
-            names[v]=gstream.str();
-            number++;
-        }
+    std::vector<Edge> candidates;
+    EdgeIterator e_it, e_it_end;
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+        candidates.push_back(*e_it);
+    }
 
-        if (PRINT_DEBUG) LG.print();
-        if (PRINT_DEBUG){
-            if (checkNodeConnected(LG, source_node, sink_node)){
-                std::cout<<"source and sink are connected"<<std::endl;
-            }
-            else{
-                std::cout<<"source and sink are not connected"<<std::endl;
-            }
+    std::mt19937 random(3);
+    std::shuffle(candidates.begin(), candidates.end(), random);
+    if ((int)candidates.size() > failures) candidates.resize(failures);
+
+    std::cout<<"Removing each of "<<candidates.size()<<" edges of a random graph with "<<num_nodes<<" nodes and "<<num_edges<<" edges\n";
+
+    std::vector<EdgeFailure> results;
+    FailureAnalysisStats stats;
+
+    if (!edgeFailureSensitivity(G, s, t, candidates, options.threads, results, stats)) return;
+
+    std::cout<<"Base flow "<<stats.baseFlow<<": "<<stats.noFlow<<" edges without flow and "<<stats.onCut<<" on the min cut skipped, ";
+    std::cout<<stats.resolved<<" forks on "<<stats.threads<<" threads touching "<<stats.touchedArcs<<" arcs, "<<stats.seconds<<" seconds wall clock\n";
+
+    // the same failures solved from scratch, preferring edges that needed a fork
+    std::vector<int> checked;
+    for (size_t c = 0; c < results.size() && (int)checked.size() < CHECKED; c++){
+        if (results[c].outcome == FAILURE_RESOLVED) checked.push_back(c);
+    }
+    for (size_t c = 0; c < results.size() && (int)checked.size() < CHECKED; c++){
+        if (results[c].outcome != FAILURE_RESOLVED) checked.push_back(c);
+    }
+
+    int wrong = 0;
+    float start_T = threadTime();
 
+    for (size_t k = 0; k < checked.size(); k++){
+        EdgeFailure& failure = results[checked[k]];
+        int cap = G[failure.e].cap;
+        G[failure.e].cap = 0;
+
+        long long flow = 0;
+        if (options.solver(G, s, t)){
+            OutEdgeIterator out_e_it, out_e_it_end;
+            InEdgeIterator in_e_it, in_e_it_end;
+            for (tie(out_e_it, out_e_it_end) = out_edges(s, G); out_e_it != out_e_it_end; out_e_it++) flow += G[*out_e_it].f;
+            for (tie(in_e_it, in_e_it_end) = in_edges(s, G); in_e_it != in_e_it_end; in_e_it++) flow -= G[*in_e_it].f;
         }
+        if (flow != failure.flow) wrong++;
 
+        G[failure.e].cap = cap;
+    }
 
-        if (print_progress) std::cout<< "Running MAX_FLOW_T\n\n";
+    float solver_T = threadTime(start_T);
 
-        start_T = leda::used_time();
-        MAX_FLOW_T(LG, source_node, sink_node, cap, flow);
-        finish_T = leda::used_time(start_T);
+    std::cout<<options.solverName<<" took "<<solver_T / std::max(1, (int)checked.size())<<" seconds per failure solved again, the analysis ";
+    std::cout<<stats.seconds / std::max(1, (int)results.size())<<" seconds per failure\n";
+    if (wrong > 0) std::cout<<wrong<<" of "<<checked.size()<<" flows differ from the solver\n";
+    std::cout<<std::endl;
 
-        complete_time_L += finish_T;
-        
-        if (print_progress) std::cout<< "MAX_FLOW_T finished with time: "<< finish_T<<" seconds\n\n";
+}
 
-        Graph BG;
 
-        Vertex b_source, b_sink;
+void dynamic_flow_evaluation(int num_nodes, int num_edges, int batches){
 
-        LEDA_Graph_To_Boost(LG, cap, flow, source_node, sink_node, BG, b_source, b_sink, names);
+    // changes applied between two solves
+    const int BATCH = 4;
 
-        if (PRINT_DEBUG) printGraphFlow(BG);
+    Graph G;
+    Vertex s, t;
+    generateRandomGraph(G, num_nodes, num_edges, 1, s, t);
 
-        if (run_checker){
-            bool res = CHECK_MAX_FLOW_T(BG, b_source, b_sink, false);
-            if (res){
-                std::cout<<"Graph has max flow\n"<<std::endl;
-            }
-            else{
-                std::cout<<"Graph does not have max flow\n"<<std::endl;
-            }
-        }
+    std::vector<Edge> edgeList;
+    EdgeIterator e_it, e_it_end;
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+        G[*e_it].f = 0;
+        edgeList.push_back(*e_it);
+    }
 
-        if (print_progress) std::cout<<"Running shortestAugmentedPath\n\n";
+    std::cout<<"Running "<<batches<<" batches of "<<BATCH<<" edge changes on a random graph with "<<num_nodes<<" nodes and "<<num_edges<<" edges\n";
 
-        start_T = leda::used_time();
-        shortestAugmentedPath(BG, b_source, b_sink);
-        finish_T = leda::used_time(start_T);
+    DynamicMaxFlow dynamic(G, s, t);
+    dynamic.solve();
 
-        complete_time_B += finish_T;
+    std::mt19937 random(4);
+    std::uniform_int_distribution<int> vertex(0, num_nodes - 1);
+    std::uniform_int_distribution<int> kind(0, 9);
+    std::uniform_int_distribution<int> capacity(100, 10000);
 
-        if (print_progress) std::cout<< "shortestAugmentedPath finished with time: "<< finish_T<<" seconds\n\n";
+    float dynamic_T = 0;
+    float solver_T = 0;
+    long long cancelled = 0, paths = 0;
+    int rebuilds = 0, not_max = 0, wrong = 0;
 
-        if (PRINT_DEBUG) printGraphFlow(BG);
+    for (int b = 0; b < batches; b++){
 
-        if (run_checker){
-            bool res = CHECK_MAX_FLOW_T(BG, b_source, b_sink, false);
-            if (res){
-                std::cout<<"Graph has max flow"<<std::endl;
+        // half capacity changes, half of them down to below the current capacity so that flow
+        // has to be cancelled, and a quarter each insertions and deletions
+        for (int c = 0; c < BATCH; c++){
+            int k = kind(random);
+            size_t pick = std::uniform_int_distribution<size_t>(0, edgeList.size() - 1)(random);
+            Edge e = edgeList[pick];
+
+            if (k < 3) dynamic.setCapacity(e, std::uniform_int_distribution<int>(0, G[e].cap)(random));
+            else if (k < 5) dynamic.setCapacity(e, capacity(random));
+            else if (k < 8){
+                Vertex u = vertex(random), w = vertex(random);
+                if (u != w) edgeList.push_back(dynamic.insertEdge(u, w, capacity(random)));
             }
             else{
-                std::cout<<"Graph does not have max flow"<<std::endl;
+                dynamic.deleteEdge(e);
+                edgeList[pick] = edgeList.back();
+                edgeList.pop_back();
             }
         }
 
-    }
+        float start_T = threadTime();
+        dynamic.solve();
+        dynamic_T += threadTime(start_T);
 
-    float avrg_L = complete_time_L / repetitions;
-    float avrg_B = complete_time_B / repetitions;
+        cancelled += dynamic.stats.cancelledFlow;
+        paths += dynamic.stats.cancelPaths;
+        if (dynamic.stats.rebuilt) rebuilds++;
 
-    std::cout<< repetitions<< " repetitions of LEDA MAX_FLOW_T took total "<< complete_time_L<< " seconds with average time "<< avrg_L<<" seconds\n\n";
-    std::cout<< repetitions<< " repetitions of shortestAugmentedPath took total "<< complete_time_B<< " seconds with average time "<< avrg_B<<" seconds\n\n";
+        // the flow of the dynamic solve is in G until the solver overwrites it
+        if (!CHECK_MAX_FLOW_T(G, s, t, false)) not_max++;
 
-}
+        long long dynamic_flow = dynamic.flowValue();
+
+        start_T = threadTime();
+        bool solved = options.solver(G, s, t);
+        solver_T += threadTime(start_T);
+
+        long long flow = 0;
+        if (solved){
+            OutEdgeIterator out_e_it, out_e_it_end;
+            InEdgeIterator in_e_it, in_e_it_end;
+            for (tie(out_e_it, out_e_it_end) = out_edges(s, G); out_e_it != out_e_it_end; out_e_it++) flow += G[*out_e_it].f;
+            for (tie(in_e_it, in_e_it_end) = in_edges(s, G); in_e_it != in_e_it_end; in_e_it++) flow -= G[*in_e_it].f;
+        }
+        if (flow != dynamic_flow) wrong++;
+    }
 
+    std::cout<<"DynamicMaxFlow took "<<dynamic_T / batches<<" seconds per batch, "<<options.solverName<<" from scratch "<<solver_T / batches<<" seconds\n";
+    std::cout<<cancelled<<" flow cancelled along "<<paths<<" paths, "<<rebuilds<<" rebuilds of the flat network\n";
+    if (not_max > 0) std::cout<<not_max<<" of "<<batches<<" flows are not maximum\n";
+    if (wrong > 0) std::cout<<wrong<<" of "<<batches<<" flow values differ from the solver\n";
+    std::cout<<std::endl;
+
+}
 
 void custom_graph(){
     /*
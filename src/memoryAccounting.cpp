@@ -0,0 +1,166 @@
+#include "memoryAccounting.hpp"
+#include <new>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <malloc.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+bool countingEnabled = false;
+
+thread_local AllocationCounters threadCounters = {0, 0, 0, 0, 0};
+
+
+void* countedAllocate(size_t size){
+
+    void* p = malloc(size ? size : 1);
+    if (!p) return NULL;
+
+    if (countingEnabled){
+        // the usable size is what free will give back, so live bytes add up to 0 again
+        long long bytes = malloc_usable_size(p);
+        threadCounters.allocations++;
+        threadCounters.bytes += bytes;
+        threadCounters.liveBytes += bytes;
+        if (threadCounters.liveBytes > threadCounters.peakLiveBytes) threadCounters.peakLiveBytes = threadCounters.liveBytes;
+    }
+
+    return p;
+
+}
+
+void countedFree(void* p){
+
+    if (!p) return;
+
+    if (countingEnabled){
+        threadCounters.frees++;
+        threadCounters.liveBytes -= malloc_usable_size(p);
+    }
+
+    free(p);
+
+}
+
+
+void* operator new(size_t size){
+    void* p = countedAllocate(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size){
+    void* p = countedAllocate(size);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept{
+    return countedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept{
+    return countedAllocate(size);
+}
+
+void operator delete(void* p) noexcept{
+    countedFree(p);
+}
+
+void operator delete[](void* p) noexcept{
+    countedFree(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept{
+    countedFree(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept{
+    countedFree(p);
+}
+
+
+void setAllocationCounting(bool enabled){
+    countingEnabled = enabled;
+}
+
+bool allocationCounting(){
+    return countingEnabled;
+}
+
+AllocationCounters threadAllocations(){
+    return threadCounters;
+}
+
+void memoryPhaseStart(AllocationCounters& start){
+    threadCounters.peakLiveBytes = threadCounters.liveBytes;
+    start = threadCounters;
+}
+
+PhaseMemory memoryPhaseEnd(const AllocationCounters& start){
+
+    PhaseMemory phase;
+    phase.allocations = threadCounters.allocations - start.allocations;
+    phase.bytes = threadCounters.bytes - start.bytes;
+    phase.peakBytes = threadCounters.peakLiveBytes - start.liveBytes;
+
+    return phase;
+
+}
+
+long peakRSSKilobytes(){
+
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return -1;
+
+    return usage.ru_maxrss;
+
+}
+
+long currentRSSKilobytes(){
+
+    FILE* statm = fopen("/proc/self/statm", "r");
+    if (!statm) return -1;
+
+    long size, resident;
+    int read = fscanf(statm, "%ld %ld", &size, &resident);
+    fclose(statm);
+
+    if (read != 2) return -1;
+
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+
+}
+
+bool resetPeakRSS(){
+
+    FILE* clearRefs = fopen("/proc/self/clear_refs", "w");
+    if (!clearRefs) return false;
+
+    bool done = fputs("5", clearRefs) >= 0;
+
+    return fclose(clearRefs) == 0 && done;
+
+}
+
+long peakRSSSinceResetKilobytes(){
+
+    FILE* status = fopen("/proc/self/status", "r");
+    if (!status) return -1;
+
+    char line[256];
+    long peak = -1;
+
+    while (fgets(line, sizeof(line), status)){
+        if (strncmp(line, "VmHWM:", 6) == 0){
+            peak = atol(line + 6);
+            break;
+        }
+    }
+
+    fclose(status);
+
+    return peak;
+
+}
@@ -0,0 +1,254 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdlib>
+#include "boostGraphStruct.hpp"
+#include "checkMaxFlow.hpp"
+#include "shortestAugmentedPath.hpp"
+#include "threadTime.hpp"
+#include "graphGenerators.hpp"
+#include "perfCounters.hpp"
+#include "arcOrdering.hpp"
+
+using namespace boost;
+
+// per phase timings of shortestAugmentedPath on fixed seed instances, compared against a
+// baseline file. every phase is run [repetitions] times and the fastest run is kept, which
+// is the least noisy number on a shared machine. exits with 1 if a phase got slower than
+// the baseline by more than the threshold. with --arc-order the arcs of every vertex are ordered
+// before the solve; running it against a baseline taken without shows the effect on the times
+
+// slowdowns smaller than this many seconds are timer noise and never count as a regression
+const float MIN_REGRESSION_T = 0.0005;
+
+// one fixed seed instance
+struct MicroInstance
+{
+    std::string name;
+    bool grid;
+    int n;
+    int m;
+    unsigned seed;
+};
+
+// times of every phase of one instance, keyed by phase name
+typedef std::map<std::string, float> PhaseTimes;
+
+// hardware counters of every phase of one instance and the arcs the phase scanned, 0 if it does not scan
+typedef std::map<std::string, std::pair<PerfSample, long long> > PhaseCounters;
+
+// arcs the advance steps of shortestAugmentedPath scanned and the advances, for the arcs per advance
+typedef std::pair<long long, long long> AdvanceScan;
+
+// runs every phase of [inst] [repetitions] times and keeps the fastest time of each. the counters
+// and [scan] are the ones of the last run
+void runPhases(const MicroInstance& inst, int repetitions, ArcOrder arcOrder, PhaseTimes& best, PhaseCounters& counters, AdvanceScan& scan);
+
+// reads "instance phase seconds" lines. returns false if the file cannot be opened
+bool readBaseline(const std::string& path, std::map<std::string, PhaseTimes>& baseline);
+
+bool writeBaseline(const std::string& path, const std::vector<MicroInstance>& instances, std::map<std::string, PhaseTimes>& results);
+
+
+int main(int argc, char* argv[])
+{
+
+    std::string baselinePath = "microbench.baseline";
+    float threshold = 10;           // percent
+    int repetitions = 5;
+    bool update = false;
+    ArcOrder arcOrder = ARC_ORDER_NONE;
+
+    for (int a = 1; a < argc; a++){
+        std::string arg = argv[a];
+
+        if (arg.compare(0, 11, "--baseline=") == 0) baselinePath = arg.substr(11);
+        else if (arg.compare(0, 12, "--threshold=") == 0) threshold = atof(arg.c_str() + 12);
+        else if (arg.compare(0, 14, "--repetitions=") == 0) repetitions = atoi(arg.c_str() + 14);
+        else if (arg == "--update") update = true;
+        else if (arg == "--perf") setPerfCounters(true);
+        else if (arg.compare(0, 12, "--arc-order=") == 0 && parseArcOrder(arg.substr(12), arcOrder)){
+            setInterleavedArcScan(arcOrder == ARC_ORDER_INTERLEAVE);
+        }
+        else{
+            std::cout<<"Unknown option: "<<arg<<std::endl;
+            return 1;
+        }
+    }
+
+    if (repetitions < 1) repetitions = 1;
+
+    std::vector<MicroInstance> instances;
+    // seeds picked so that the main loop runs for a measurable time
+    instances.push_back({"random-1000-8000", false, 1000, 8000, 1});
+    instances.push_back({"random-2000-10000", false, 2000, 10000, 3});
+    instances.push_back({"grid-60", true, 60, 0, 3});
+
+    std::map<std::string, PhaseTimes> results;
+    std::map<std::string, PhaseCounters> counters;
+    std::map<std::string, AdvanceScan> scans;
+
+    for (size_t k = 0; k < instances.size(); k++){
+        runPhases(instances[k], repetitions, arcOrder, results[instances[k].name], counters[instances[k].name], scans[instances[k].name]);
+    }
+
+    std::map<std::string, PhaseTimes> baseline;
+    bool haveBaseline = !update && readBaseline(baselinePath, baseline);
+
+    bool regression = false;
+
+    std::cout<<"instance             phase          seconds      baseline     change"<<std::endl;
+
+    for (size_t k = 0; k < instances.size(); k++){
+        const std::string& name = instances[k].name;
+
+        for (PhaseTimes::iterator p = results[name].begin(); p != results[name].end(); p++){
+            std::cout.width(21);
+            std::cout<<std::left<<name;
+            std::cout.width(15);
+            std::cout<<p->first;
+            std::cout.width(13);
+            std::cout<<p->second;
+
+            if (haveBaseline && baseline[name].count(p->first)){
+                float base = baseline[name][p->first];
+                float change = base > 0 ? 100 * (p->second - base) / base : 0;
+
+                std::cout.width(13);
+                std::cout<<base;
+                std::cout<<change<<"%";
+
+                if (change > threshold && p->second - base > MIN_REGRESSION_T){
+                    std::cout<<"  REGRESSION";
+                    regression = true;
+                }
+            }
+            std::cout<<std::endl;
+        }
+    }
+
+    std::cout<<std::endl<<"Arc order "<<arcOrderName(arcOrder)<<":"<<std::endl;
+    for (size_t k = 0; k < instances.size(); k++){
+        const AdvanceScan& scan = scans[instances[k].name];
+        std::cout<<instances[k].name<<": "<<(scan.second > 0 ? (double)scan.first / scan.second : 0)<<" arcs scanned per advance over "<<scan.second<<" advances"<<std::endl;
+    }
+
+    // the counters are not compared against the baseline, they explain the times
+    if (perfCountersAvailable()){
+        std::cout<<std::endl;
+        for (size_t k = 0; k < instances.size(); k++){
+            const std::string& name = instances[k].name;
+            for (PhaseCounters::iterator p = counters[name].begin(); p != counters[name].end(); p++){
+                std::cout<<name<<" "<<p->first<<": "<<perfSummary(p->second.first, p->second.second)<<std::endl;
+            }
+        }
+    }
+
+    if (!haveBaseline){
+        if (!writeBaseline(baselinePath, instances, results)){
+            std::cout<<"Could not write the baseline "<<baselinePath<<std::endl;
+            return 1;
+        }
+        std::cout<<std::endl<<"Baseline written to "<<baselinePath<<std::endl;
+        return 0;
+    }
+
+    if (regression){
+        std::cout<<std::endl<<"Some phases are more than "<<threshold<<"% slower than "<<baselinePath<<std::endl;
+        return 1;
+    }
+
+    return 0;
+
+}
+
+void runPhases(const MicroInstance& inst, int repetitions, ArcOrder arcOrder, PhaseTimes& best, PhaseCounters& counters, AdvanceScan& scan){
+
+    float T = 0;
+
+    for (int r = 0; r < repetitions; r++){
+
+        PhaseTimes times;
+
+        Graph G;
+        Vertex s, t;
+
+        PerfReading start;
+
+        threadTime(T);
+        perfPhaseStart(start);
+        if (inst.grid) generateGridGraph(G, inst.n, inst.seed, s, t);
+        else generateRandomGraph(G, inst.n, inst.m, inst.seed, s, t);
+        times["construction"] = threadTime(T);
+        counters["construction"] = std::make_pair(perfPhaseEnd(start), 0LL);
+
+        if (arcOrder == ARC_ORDER_DISTANCE || arcOrder == ARC_ORDER_CAPACITY){
+            threadTime(T);
+            orderArcs(G, t, arcOrder);
+            times["arcOrder"] = threadTime(T);
+        }
+
+        // the loop counters include the augment steps, which are too short to be read one by one
+        SapPhaseTimes sap;
+        shortestAugmentedPath(G, s, t, &sap);
+        times["calcDist"] = sap.dist;
+        times["sapLoop"] = sap.loop;
+        times["augment"] = sap.augment;
+        counters["calcDist"] = std::make_pair(sap.distCounters, 0LL);
+        counters["sapLoop"] = std::make_pair(sap.loopCounters, sap.arcsScanned);
+        scan = std::make_pair(sap.advanceArcs, sap.advances);
+
+        threadTime(T);
+        perfPhaseStart(start);
+        bool correct = CHECK_MAX_FLOW_T(G, s, t);
+        times["checkMaxFlow"] = threadTime(T);
+        counters["checkMaxFlow"] = std::make_pair(perfPhaseEnd(start), 0LL);
+
+        if (!correct) std::cout<<inst.name<<": shortestAugmentedPath did not find a max flow"<<std::endl;
+
+        for (PhaseTimes::iterator p = times.begin(); p != times.end(); p++){
+            if (r == 0 || p->second < best[p->first]) best[p->first] = p->second;
+        }
+    }
+
+}
+
+bool readBaseline(const std::string& path, std::map<std::string, PhaseTimes>& baseline){
+
+    std::ifstream in(path.c_str());
+    if (!in) return false;
+
+    std::string line;
+    while (std::getline(in, line)){
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream fields(line);
+        std::string instance, phase;
+        float seconds;
+        if (fields >> instance >> phase >> seconds) baseline[instance][phase] = seconds;
+    }
+
+    return true;
+
+}
+
+bool writeBaseline(const std::string& path, const std::vector<MicroInstance>& instances, std::map<std::string, PhaseTimes>& results){
+
+    std::ofstream out(path.c_str());
+    if (!out) return false;
+
+    out<<"# instance phase seconds"<<std::endl;
+
+    for (size_t k = 0; k < instances.size(); k++){
+        const std::string& name = instances[k].name;
+        for (PhaseTimes::iterator p = results[name].begin(); p != results[name].end(); p++){
+            out<<name<<" "<<p->first<<" "<<p->second<<std::endl;
+        }
+    }
+
+    return true;
+
+}
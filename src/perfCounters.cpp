@@ -0,0 +1,183 @@
+#include <iostream>
+#include <sstream>
+#include "perfCounters.hpp"
+#include <atomic>
+#include <cstring>
+#include <cerrno>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// counters of one thread. fd is -1 for events that could not be opened
+struct ThreadPerfCounters
+{
+    int fd[PERF_EVENTS];
+    bool opened;
+
+    ThreadPerfCounters() : opened(false){
+        for (int k = 0; k < PERF_EVENTS; k++) fd[k] = -1;
+    }
+
+    ~ThreadPerfCounters(){
+        for (int k = 0; k < PERF_EVENTS; k++){
+            if (fd[k] >= 0) close(fd[k]);
+        }
+    }
+};
+
+std::atomic<bool> perfEnabled(false);
+std::atomic<bool> perfWarned(false);
+thread_local ThreadPerfCounters threadPerfCounters;
+
+// opens the counters of the calling thread once
+ThreadPerfCounters& openThreadCounters();
+
+// reads the counters of the calling thread
+void perfRead(PerfReading& reading);
+
+
+void setPerfCounters(bool enabled){
+    perfEnabled = enabled;
+}
+
+bool perfCountersEnabled(){
+    return perfEnabled;
+}
+
+bool perfCountersAvailable(){
+    return perfEnabled && openThreadCounters().fd[PERF_CYCLES] >= 0;
+}
+
+void perfPhaseStart(PerfReading& start){
+    perfRead(start);
+}
+
+PerfSample perfPhaseEnd(const PerfReading& start){
+
+    PerfReading end;
+    perfRead(end);
+
+    PerfSample sample;
+
+    for (int k = 0; k < PERF_EVENTS; k++){
+        sample.counted[k] = perfEnabled && threadPerfCounters.fd[k] >= 0;
+        sample.count[k] = 0;
+
+        if (!sample.counted[k]) continue;
+
+        long long value = end.value[k] - start.value[k];
+        long long enabled = end.enabled[k] - start.enabled[k];
+        long long running = end.running[k] - start.running[k];
+
+        // the kernel only counted for [running] of the [enabled] ns, the rest is estimated
+        if (running > 0 && running < enabled) value = (long long)((double)value * enabled / running);
+        sample.count[k] = value;
+    }
+
+    return sample;
+
+}
+
+const char* perfEventName(int event){
+
+    static const char* names[PERF_EVENTS] = {"cycles", "instructions", "L1d-misses", "LLC-misses", "branch-misses", "dTLB-misses"};
+
+    return event >= 0 && event < PERF_EVENTS ? names[event] : "unknown";
+
+}
+
+std::string perfSummary(const PerfSample& sample, long long arcs){
+
+    std::stringstream line;
+
+    for (int k = 0; k < PERF_EVENTS; k++){
+        line<<(k > 0 ? ", " : "")<<perfEventName(k)<<" ";
+        if (sample.counted[k]) line<<sample.count[k];
+        else line<<"n/a";
+    }
+
+    if (sample.counted[PERF_CYCLES] && sample.counted[PERF_INSTRUCTIONS] && sample.count[PERF_CYCLES] > 0){
+        line<<", IPC "<<(double)sample.count[PERF_INSTRUCTIONS] / sample.count[PERF_CYCLES];
+    }
+
+    if (arcs > 0){
+        line<<", per arc scanned:";
+        for (int k = PERF_L1D_MISSES; k < PERF_EVENTS; k++){
+            if (sample.counted[k]) line<<" "<<perfEventName(k)<<" "<<(double)sample.count[k] / arcs;
+        }
+        if (sample.counted[PERF_CYCLES]) line<<" cycles "<<(double)sample.count[PERF_CYCLES] / arcs;
+    }
+
+    return line.str();
+
+}
+
+ThreadPerfCounters& openThreadCounters(){
+
+    ThreadPerfCounters& counters = threadPerfCounters;
+
+    if (counters.opened) return counters;
+    counters.opened = true;
+
+    const unsigned int L1D_READ_MISS = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    const unsigned int DTLB_READ_MISS = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+
+    const unsigned int types[PERF_EVENTS] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE};
+    const unsigned long long configs[PERF_EVENTS] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, L1D_READ_MISS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES, DTLB_READ_MISS};
+
+    int error = 0;
+
+    for (int k = 0; k < PERF_EVENTS; k++){
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = types[k];
+        attr.config = configs[k];
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        // this thread on any cpu, counting from now on
+        counters.fd[k] = syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+        if (counters.fd[k] < 0 && k == PERF_CYCLES) error = errno;
+    }
+
+    // without cycles there is nothing to relate the other counts to
+    if (counters.fd[PERF_CYCLES] < 0){
+        for (int k = 0; k < PERF_EVENTS; k++){
+            if (counters.fd[k] >= 0) close(counters.fd[k]);
+            counters.fd[k] = -1;
+        }
+
+        if (!perfWarned.exchange(true)){
+            std::cout<<"Hardware counters are not available ("<<strerror(error)<<"), only times are reported";
+            if (error == EACCES || error == EPERM) std::cout<<". Lower /proc/sys/kernel/perf_event_paranoid to allow them";
+            std::cout<<std::endl;
+        }
+    }
+
+    return counters;
+
+}
+
+void perfRead(PerfReading& reading){
+
+    ThreadPerfCounters& counters = perfEnabled ? openThreadCounters() : threadPerfCounters;
+
+    for (int k = 0; k < PERF_EVENTS; k++){
+        reading.value[k] = 0;
+        reading.enabled[k] = 0;
+        reading.running[k] = 0;
+
+        if (!perfEnabled || counters.fd[k] < 0) continue;
+
+        // value, time enabled, time running
+        unsigned long long data[3];
+        if (read(counters.fd[k], data, sizeof(data)) != (ssize_t)sizeof(data)) continue;
+
+        reading.value[k] = data[0];
+        reading.enabled[k] = data[1];
+        reading.running[k] = data[2];
+    }
+
+}
@@ -0,0 +1,227 @@
+#include <iostream>
+#include "boostGraphStruct.hpp"
+#include "planarGridFlow.hpp"
+#include "flatShortestAugmentedPath.hpp"
+#include <cmath>
+#include <queue>
+#include <climits>
+
+using namespace boost;
+
+// faces of the grid. cell (x, y) has (x, y) as its top left corner and is y * (n - 1) + x. the
+// outer face is split at s and t into the face above and right of the grid and the face below
+// and left of it, numbered after the cells
+inline int upperRightFace(int n){ return (n - 1) * (n - 1); }
+inline int lowerLeftFace(int n){ return (n - 1) * (n - 1) + 1; }
+
+// edge k is right edge k for k < n(n-1) and down edge k - n(n-1) after that. returns the face
+// on the left and on the right of edge k when walking along it
+void edgeFaces(int n, int k, int& left, int& right);
+
+bool planarGridMaxFlow(Graph& G, const PlanarGrid& P){
+
+    PlanarGridResult result;
+    planarGridMaxFlow(G, P, result);
+
+    if (result.flow == 0){
+        std::cout<<"t is not reachable from s"<<std::endl;
+        return false;
+    }
+
+    return true;
+
+}
+
+bool planarGridMaxFlow(Graph& G, Vertex s, Vertex t){
+
+    PlanarGrid P;
+
+    if (!recognizePlanarGrid(G, s, t, P)){
+        return flatShortestAugmentedPath(G, s, t);
+    }
+
+    return planarGridMaxFlow(G, P);
+
+}
+
+bool recognizePlanarGrid(Graph& G, Vertex s, Vertex t, PlanarGrid& P){
+
+    EdgeIterator e_it, e_it_end;
+
+    int vertices = num_vertices(G);
+    int n = (int)(std::sqrt((double)vertices) + 0.5);
+
+    if (n < 2 || n * n != vertices) return false;
+    if (s != 0 || (int)t != vertices - 1) return false;
+    if ((long long)num_edges(G) != 2LL * n * (n - 1)) return false;
+
+    P.n = n;
+    P.rightEdge.assign(n * (n - 1), Edge());
+    P.downEdge.assign(n * (n - 1), Edge());
+
+    std::vector<bool> haveRight(n * (n - 1), false);
+    std::vector<bool> haveDown(n * (n - 1), false);
+
+    // every edge has to fill its own slot. with the edge count above all slots are then filled
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+        int u = source(*e_it, G);
+        int w = target(*e_it, G);
+        int i = u % n;
+        int y = u / n;
+
+        if (w == u + 1 && i < n - 1){
+            int k = y * (n - 1) + i;
+            if (haveRight[k]) return false;
+            haveRight[k] = true;
+            P.rightEdge[k] = *e_it;
+        }
+        else if (w == u + n){
+            int k = y * n + i;
+            if (haveDown[k]) return false;
+            haveDown[k] = true;
+            P.downEdge[k] = *e_it;
+        }
+        else return false;
+    }
+
+    return true;
+
+}
+
+void planarGridMaxFlow(Graph& G, const PlanarGrid& P, PlanarGridResult& result){
+
+    int n = P.n;
+    int rights = n * (n - 1);
+    int m = 2 * rights;
+
+    const int upperRight = upperRightFace(n);
+    const int lowerLeft = lowerLeftFace(n);
+    const int faces = lowerLeft + 1;
+
+    // capacities in edge order, so that the dual search does not go through the edge lists
+    std::vector<int> cap(m);
+    for (int k = 0; k < rights; k++){
+        cap[k] = G[P.rightEdge[k]].cap;
+        cap[rights + k] = G[P.downEdge[k]].cap;
+    }
+
+    // dijkstra from the upper right face over the dual. crossing an edge from its left face to its
+    // right face costs its capacity, crossing it back costs 0. the arcs of a face are read off the
+    // grid: a cell is the right face of the right edge above it and the down edge right of it, and
+    // the left face of the right edge below it and the down edge left of it
+
+    std::vector<long long> phi(faces, LLONG_MAX);
+    std::vector<int> pred(faces, -1);      // 2k + 1 if reached over edge k forward, 2k if backward
+    std::vector<bool> done(faces, false);
+
+    typedef std::pair<long long, int> QueueEntry;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry> > queue;
+
+    phi[upperRight] = 0;
+    queue.push(QueueEntry(0, upperRight));
+
+    // edges around the face being scanned and whether the face is their left face
+    int around[4];
+    bool isLeft[4];
+    std::vector<int> border;
+
+    while (!queue.empty()){
+        int f = queue.top().second;
+        queue.pop();
+
+        if (done[f]) continue;
+        done[f] = true;
+
+        // every face that is not settled yet is at least as far as the sink face
+        if (f == lowerLeft) break;
+
+        const int* scan = around;
+        int count;
+
+        if (f == upperRight){
+            // left face of the top row right edges and of the last column down edges
+            border.clear();
+            for (int i = 0; i < n - 1; i++) border.push_back(i);
+            for (int y = 0; y < n - 1; y++) border.push_back(rights + y * n + n - 1);
+            scan = border.data();
+            count = border.size();
+        }
+        else{
+            int x = f % (n - 1);
+            int y = f / (n - 1);
+            around[0] = y * (n - 1) + x;            isLeft[0] = false;
+            around[1] = (y + 1) * (n - 1) + x;      isLeft[1] = true;
+            around[2] = rights + y * n + x;         isLeft[2] = true;
+            around[3] = rights + y * n + x + 1;     isLeft[3] = false;
+            count = 4;
+        }
+
+        for (int a = 0; a < count; a++){
+            int k = scan[a];
+            // the upper right face is only ever a left face
+            bool forward = f == upperRight || isLeft[a];
+
+            int left, right;
+            edgeFaces(n, k, left, right);
+
+            int g = forward ? right : left;
+            long long d = phi[f] + (forward ? cap[k] : 0);
+            if (d < phi[g]){
+                phi[g] = d;
+                pred[g] = 2 * k + (forward ? 1 : 0);
+                queue.push(QueueEntry(d, g));
+            }
+        }
+    }
+
+    result.flow = phi[lowerLeft];
+
+    // min(phi, flow) is still a feasible potential, so the faces that were not settled can all
+    // take the flow value. phi(right) - phi(left) is at most cap because of the forward arcs and
+    // at least 0 because of the backward arcs. around every vertex but s and t the differences
+    // cancel out, so this is a flow
+    for (int f = 0; f < faces; f++){
+        if (phi[f] > result.flow) phi[f] = result.flow;
+    }
+
+    for (int k = 0; k < m; k++){
+        int left, right;
+        edgeFaces(n, k, left, right);
+        G[k < rights ? P.rightEdge[k] : P.downEdge[k - rights]].f = (int)(phi[right] - phi[left]);
+    }
+
+    // the forward arcs of the shortest path are the saturated edges of the cut
+    result.cut.clear();
+    for (int f = lowerLeft; f != upperRight; ){
+        int k = pred[f] / 2;
+        bool forward = pred[f] % 2;
+
+        int left, right;
+        edgeFaces(n, k, left, right);
+
+        if (forward) result.cut.push_back(k < rights ? P.rightEdge[k] : P.downEdge[k - rights]);
+        f = forward ? left : right;
+    }
+
+}
+
+void edgeFaces(int n, int k, int& left, int& right){
+
+    int rights = n * (n - 1);
+
+    if (k < rights){
+        // pointing right, the cell above is on the left
+        int i = k % (n - 1);
+        int y = k / (n - 1);
+        left = y > 0 ? (y - 1) * (n - 1) + i : upperRightFace(n);
+        right = y < n - 1 ? y * (n - 1) + i : lowerLeftFace(n);
+    }
+    else{
+        // pointing down, the cell to the right is on the left
+        int x = (k - rights) % n;
+        int y = (k - rights) / n;
+        left = x < n - 1 ? y * (n - 1) + x : upperRightFace(n);
+        right = x > 0 ? y * (n - 1) + x - 1 : lowerLeftFace(n);
+    }
+
+}
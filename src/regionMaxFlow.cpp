@@ -0,0 +1,557 @@
+#include <iostream>
+#include "boostGraphStruct.hpp"
+#include "regionMaxFlow.hpp"
+#include "flatShortestAugmentedPath.hpp"
+#include "planarGridFlow.hpp"
+#include "benchmarkPipeline.hpp"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+
+using namespace boost;
+
+// vertices per region, so that the labels, excess and arcs of a region fit in the L2 cache
+const int REGION_VERTICES = 1 << 14;
+
+// smallest region the MaxFlowSolver version makes
+const int MIN_REGION_VERTICES = 64;
+
+int regionThreads = 0;      // 0 : number of cores
+
+RegionSolveStats lastRegionStats = {0, 0, 0, 0, 0, 0, 0};
+
+// state of one solve shared by the threads. during a sweep the labels, excess and current arcs of
+// a vertex and the boundary buffer of an arc are only written by the region that owns the vertex
+// or the tail of the arc
+struct RegionState
+{
+    FlatNetwork* N;
+    int s;
+    int t;
+    const std::vector<int>* first;
+
+    BulkVector<int> d;                      // labels
+    BulkVector<int> dOld;                   // labels at the start of the sweep, read only during it
+    BulkVector<long long> excess;
+    BulkVector<int> current;                // current arc of every vertex
+    BulkVector<int> pushed;                 // flow pushed over a boundary arc in this sweep
+    BulkVector<char> queued;                // vertex is in the queue of its region
+    std::vector<std::vector<int> > boundary;    // arcs of every region whose head is in another region
+    std::vector<int> regionOf;
+    std::vector<char> regionActive;         // region has a vertex with excess and a label below n
+    std::vector<int> sweepRegions;          // active regions of the current sweep
+
+    std::atomic<int> nextRegion;
+    std::atomic<long long> pushes;
+    std::atomic<long long> relabels;
+    std::atomic<long long> boundaryPushes;
+
+    // the worker threads live for the whole solve. a new generation starts a sweep of
+    // sweepActive regions, and each worker counts itself in finished once it found none left
+    std::mutex poolMutex;
+    std::condition_variable sweepStart;
+    std::condition_variable sweepDone;
+    int generation;
+    int sweepActive;
+    int finished;
+    bool stop;
+};
+
+// discharges every active vertex of region r until the region has no active vertex left
+void dischargeRegion(RegionState& S, int r, std::vector<int>& queue);
+
+
+// worker [k] of the pool: discharges regions of every sweep until the solve stops
+void regionWorker(RegionState& S, int k, int cores);
+
+// applies the flow pushed over boundary arcs in the last sweep to the residuals and the excess
+// and marks the regions that got excess as active
+void exchangeBoundary(RegionState& S);
+
+// second phase: pushes the excess that cannot reach t back to s
+void returnExcess(RegionState& S);
+
+
+bool regionMaxFlow(Graph& G, Vertex s, Vertex t){
+
+    EdgeIterator e_it, e_it_end;
+
+    // flow = 0
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+        G[*e_it].f = 0;
+    }
+
+    int threads = regionThreads > 0 ? regionThreads : numberOfCores();
+    int n = num_vertices(G);
+
+    // small enough for the cache and for two regions per thread
+    int regionSize = std::min(REGION_VERTICES, (n + 2 * threads - 1) / (2 * threads));
+    regionSize = std::max(regionSize, MIN_REGION_VERTICES);
+
+    RegionPartition P;
+    PlanarGrid grid;
+
+    if (recognizePlanarGrid(G, s, t, grid)) gridRegions(grid.n, std::max(8, (int)std::sqrt((double)regionSize)), P);
+    else bfsRegions(G, s, regionSize, P);
+
+    FlatNetwork N;
+    buildFlatNetwork(G, P.index, N);
+
+    regionMaxFlow(N, P.index[s], P.index[t], P.first, threads, lastRegionStats);
+
+    writeFlatFlow(G, N);
+
+    if (flatFlowValue(N, P.index[s]) == 0){
+        std::cout<<"t is not reachable from s"<<std::endl;
+        return false;
+    }
+
+    return true;
+
+}
+
+void setRegionThreads(int threads){
+    regionThreads = threads;
+}
+
+RegionSolveStats regionSolveStats(){
+    return lastRegionStats;
+}
+
+void gridRegions(int n, int tile, RegionPartition& P){
+
+    int tiles = (n + tile - 1) / tile;
+    int next = 0;
+
+    P.index.assign(n * n, 0);
+    P.first.assign(1, 0);
+
+    // tiles row by row, the vertices of a tile row by row
+    for (int ty = 0; ty < tiles; ty++){
+        for (int tx = 0; tx < tiles; tx++){
+            for (int y = ty * tile; y < std::min(n, (ty + 1) * tile); y++){
+                for (int i = tx * tile; i < std::min(n, (tx + 1) * tile); i++){
+                    P.index[y * n + i] = next++;
+                }
+            }
+            P.first.push_back(next);
+        }
+    }
+
+}
+
+void bfsRegions(Graph& G, Vertex s, int regionSize, RegionPartition& P){
+
+    OutEdgeIterator out_e_it, out_e_it_end;
+    InEdgeIterator in_e_it, in_e_it_end;
+
+    int n = num_vertices(G);
+
+    P.index.assign(n, -1);
+
+    std::vector<int> queue;
+    queue.reserve(n);
+
+    int root = s;
+    int unvisited = 0;
+
+    while ((int)queue.size() < n){
+
+        P.index[root] = queue.size();
+        queue.push_back(root);
+
+        for (size_t q = queue.size() - 1; q < queue.size(); q++){
+            int v = queue[q];
+            for (tie(out_e_it, out_e_it_end) = out_edges(v, G); out_e_it != out_e_it_end; out_e_it++){
+                int w = target(*out_e_it, G);
+                if (P.index[w] >= 0) continue;
+                P.index[w] = queue.size();
+                queue.push_back(w);
+            }
+            for (tie(in_e_it, in_e_it_end) = in_edges(v, G); in_e_it != in_e_it_end; in_e_it++){
+                int w = source(*in_e_it, G);
+                if (P.index[w] >= 0) continue;
+                P.index[w] = queue.size();
+                queue.push_back(w);
+            }
+        }
+
+        while (unvisited < n && P.index[unvisited] >= 0) unvisited++;
+        root = unvisited;
+    }
+
+    // consecutive runs of the bfs order
+    P.first.clear();
+    for (int v = 0; v < n; v += regionSize){
+        P.first.push_back(v);
+    }
+    P.first.push_back(n);
+
+}
+
+void regionMaxFlow(FlatNetwork& N, int s, int t, const std::vector<int>& first, int threads, RegionSolveStats& stats){
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    int n = N.n;
+    int regions = first.size() - 1;
+
+    if (threads < 1) threads = 1;
+    if (threads > regions) threads = regions;
+
+    RegionState S;
+    S.N = &N;
+    S.s = s;
+    S.t = t;
+    S.first = &first;
+
+    S.d.assign(n, 0);
+    S.excess.assign(n, 0);
+    S.current.assign(n, 0);
+    S.pushed.assign(N.head.size(), 0);
+    S.queued.assign(n, 0);
+
+    S.regionOf.assign(n, 0);
+    S.regionActive.assign(regions, 0);
+    S.boundary.assign(regions, std::vector<int>());
+    for (int r = 0; r < regions; r++){
+        for (int v = first[r]; v < first[r + 1]; v++){
+            S.regionOf[v] = r;
+        }
+        for (int a = N.first[first[r]]; a < N.first[first[r + 1]]; a++){
+            if (N.head[a] < first[r] || N.head[a] >= first[r + 1]) S.boundary[r].push_back(a);
+        }
+    }
+
+    S.pushes = 0;
+    S.relabels = 0;
+    S.boundaryPushes = 0;
+
+    S.generation = 0;
+    S.sweepActive = 0;
+    S.finished = 0;
+    S.stop = false;
+
+    // the calling thread is worker 0, the others are pinned to their own cores
+    int cores = numberOfCores();
+    std::vector<std::thread> workers;
+    for (int k = 1; k < threads; k++){
+        workers.push_back(std::thread(regionWorker, std::ref(S), k, cores));
+    }
+
+    stats.regions = regions;
+    stats.threads = threads;
+    stats.sweeps = 0;
+
+    bool exact = false;
+    bool relabel = true;
+    long long relabelsBefore = 0;
+
+    std::vector<int> queue;
+
+    while (true){
+
+        if (relabel){
+            // boundary flow can leave labels that are no longer valid. exact labels fix that, and
+            // the sweeps stop only once no active vertex can reach t under exact labels
+            flatExactLabels(N, t, S.d);
+
+            // s can reach t again, so it has residual arcs worth saturating. the first time
+            // this is the initial preflow
+            if (S.d[s] < n){
+                for (int a = N.first[s]; a < N.first[s + 1]; a++){
+                    int delta = N.residual[a];
+                    if (delta <= 0) continue;
+                    N.residual[a] = 0;
+                    N.residual[N.mate[a]] += delta;
+                    S.excess[N.head[a]] += delta;
+                }
+            }
+
+            S.d[s] = n;
+            S.dOld = S.d;
+
+            for (int v = 0; v < n; v++){
+                if (v != s && v != t && S.excess[v] > 0 && S.d[v] < n) S.regionActive[S.regionOf[v]] = 1;
+            }
+
+            exact = true;
+            relabel = false;
+            relabelsBefore = S.relabels;
+        }
+
+        // only the regions with active vertices take part in a sweep. late sweeps often move a
+        // little excess between a few regions, so nothing in a sweep is O(n)
+        S.sweepRegions.clear();
+        for (int r = 0; r < regions; r++){
+            if (S.regionActive[r]) S.sweepRegions.push_back(r);
+        }
+
+        if (S.sweepRegions.empty()){
+            if (exact) break;
+            relabel = true;
+            continue;
+        }
+
+        int active = S.sweepRegions.size();
+        S.nextRegion = 0;
+
+        {
+            std::lock_guard<std::mutex> lock(S.poolMutex);
+            S.sweepActive = active;
+            S.finished = 0;
+            S.generation++;
+        }
+        S.sweepStart.notify_all();
+
+        for (int i = S.nextRegion++; i < active; i = S.nextRegion++){
+            dischargeRegion(S, S.sweepRegions[i], queue);
+        }
+
+        {
+            std::unique_lock<std::mutex> lock(S.poolMutex);
+            S.sweepDone.wait(lock, [&S, &workers]{ return S.finished == (int)workers.size(); });
+        }
+
+        // the labels other regions see in the next sweep. only the regions of this sweep changed
+        for (int i = 0; i < active; i++){
+            int r = S.sweepRegions[i];
+            std::copy(S.d.begin() + first[r], S.d.begin() + first[r + 1], S.dOld.begin() + first[r]);
+            S.regionActive[r] = 0;
+        }
+
+        exchangeBoundary(S);
+        stats.sweeps++;
+
+        // the bfs costs O(m), so it is only repeated once the sweeps have relabelled about n/2 times
+        exact = false;
+        relabel = S.relabels - relabelsBefore > n / 2;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(S.poolMutex);
+        S.stop = true;
+    }
+    S.sweepStart.notify_all();
+
+    for (size_t k = 0; k < workers.size(); k++){
+        workers[k].join();
+    }
+
+    returnExcess(S);
+
+    stats.pushes = S.pushes;
+    stats.relabels = S.relabels;
+    stats.boundaryPushes = S.boundaryPushes;
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+}
+
+void regionWorker(RegionState& S, int k, int cores){
+
+    pinThreadToCore(k % cores);
+
+    std::vector<int> queue;
+    int seen = 0;
+
+    while (true){
+
+        int active;
+        {
+            std::unique_lock<std::mutex> lock(S.poolMutex);
+            S.sweepStart.wait(lock, [&S, seen]{ return S.stop || S.generation != seen; });
+            if (S.stop) return;
+            seen = S.generation;
+            active = S.sweepActive;
+        }
+
+        for (int i = S.nextRegion++; i < active; i = S.nextRegion++){
+            dischargeRegion(S, S.sweepRegions[i], queue);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(S.poolMutex);
+            S.finished++;
+        }
+        S.sweepDone.notify_one();
+    }
+
+}
+
+void dischargeRegion(RegionState& S, int r, std::vector<int>& queue){
+
+    FlatNetwork& N = *S.N;
+    int n = N.n;
+    int lo = (*S.first)[r];
+    int hi = (*S.first)[r + 1];
+
+    long long pushes = 0;
+    long long relabels = 0;
+    long long boundaryPushes = 0;
+
+    queue.clear();
+
+    for (int v = lo; v < hi; v++){
+        S.current[v] = N.first[v];
+        if (v != S.s && v != S.t && S.excess[v] > 0 && S.d[v] < n){
+            S.queued[v] = 1;
+            queue.push_back(v);
+        }
+    }
+
+    size_t q = 0;
+
+    while (q < queue.size()){
+
+        int v = queue[q++];
+        S.queued[v] = 0;
+
+        // drop the part of the queue that was already handled once it is most of it
+        if (q > 4096 && 2 * q > queue.size()){
+            queue.erase(queue.begin(), queue.begin() + q);
+            q = 0;
+        }
+
+        while (S.excess[v] > 0){
+
+            if (S.current[v] == N.first[v + 1]){
+                // relabel. other regions are seen with the labels of the start of the sweep. the
+                // labels are only valid right after an exact relabel, so the label is raised by at
+                // least one to keep the sweep from looping
+                int mind = n;
+                for (int a = N.first[v]; a < N.first[v + 1]; a++){
+                    int w = N.head[a];
+                    bool inside = w >= lo && w < hi;
+                    if (N.residual[a] - (inside ? 0 : S.pushed[a]) <= 0) continue;
+                    mind = std::min(mind, inside ? S.d[w] : S.dOld[w]);
+                }
+
+                S.d[v] = std::min(n, std::max(S.d[v], mind) + 1);
+                S.current[v] = N.first[v];
+                relabels++;
+
+                if (S.d[v] >= n) break;
+                continue;
+            }
+
+            int a = S.current[v];
+            int w = N.head[a];
+            bool inside = w >= lo && w < hi;
+
+            int residual = N.residual[a] - (inside ? 0 : S.pushed[a]);
+
+            if (residual <= 0 || S.d[v] != (inside ? S.d[w] : S.dOld[w]) + 1){
+                S.current[v]++;
+                continue;
+            }
+
+            int delta = (int)std::min<long long>(S.excess[v], residual);
+            S.excess[v] -= delta;
+            pushes++;
+
+            if (inside){
+                N.residual[a] -= delta;
+                N.residual[N.mate[a]] += delta;
+                S.excess[w] += delta;
+                if (w != S.s && w != S.t && !S.queued[w]){
+                    S.queued[w] = 1;
+                    queue.push_back(w);
+                }
+            }
+            else{
+                // the other region gets it between sweeps
+                S.pushed[a] += delta;
+                boundaryPushes++;
+            }
+        }
+    }
+
+    S.pushes += pushes;
+    S.relabels += relabels;
+    S.boundaryPushes += boundaryPushes;
+
+}
+
+void exchangeBoundary(RegionState& S){
+
+    FlatNetwork& N = *S.N;
+
+    for (size_t i = 0; i < S.sweepRegions.size(); i++){
+        const std::vector<int>& arcs = S.boundary[S.sweepRegions[i]];
+        for (size_t k = 0; k < arcs.size(); k++){
+            int a = arcs[k];
+            int delta = S.pushed[a];
+            if (delta == 0) continue;
+            N.residual[a] -= delta;
+            N.residual[N.mate[a]] += delta;
+            S.excess[N.head[a]] += delta;
+            S.pushed[a] = 0;
+
+            int w = N.head[a];
+            if (w != S.s && w != S.t && S.d[w] < N.n) S.regionActive[S.regionOf[w]] = 1;
+        }
+    }
+
+}
+
+void returnExcess(RegionState& S){
+
+    FlatNetwork& N = *S.N;
+    int n = N.n;
+    int s = S.s;
+    int t = S.t;
+
+    // the excess left cannot reach t, and neither can anything it is pushed to, so with labels
+    // that are the distance to s this is push-relabel with s as the sink
+    flatExactLabels(N, s, S.d);
+
+    std::vector<int> queue;
+    for (int v = 0; v < n; v++){
+        S.queued[v] = v != s && v != t && S.excess[v] > 0;
+        if (S.queued[v]) queue.push_back(v);
+    }
+
+    for (size_t q = 0; q < queue.size(); q++){
+
+        int v = queue[q];
+        S.queued[v] = 0;
+
+        int a = N.first[v];
+
+        while (S.excess[v] > 0){
+
+            if (a == N.first[v + 1]){
+                int mind = 2 * n;
+                for (int b = N.first[v]; b < N.first[v + 1]; b++){
+                    if (N.residual[b] > 0) mind = std::min(mind, S.d[N.head[b]]);
+                }
+                S.d[v] = mind + 1;
+                a = N.first[v];
+                continue;
+            }
+
+            int w = N.head[a];
+
+            if (N.residual[a] <= 0 || S.d[v] != S.d[w] + 1){
+                a++;
+                continue;
+            }
+
+            int delta = (int)std::min<long long>(S.excess[v], N.residual[a]);
+            N.residual[a] -= delta;
+            N.residual[N.mate[a]] += delta;
+            S.excess[v] -= delta;
+            S.excess[w] += delta;
+
+            if (w != s && w != t && !S.queued[w]){
+                S.queued[w] = 1;
+                queue.push_back(w);
+            }
+        }
+    }
+
+}
@@ -2,24 +2,38 @@
 #include "boostGraphStruct.hpp"
 #include "shortestAugmentedPath.hpp"
 #include "visitor_graph.hpp"
+#include "threadTime.hpp"
+#include "traceSpans.hpp"
+#include "solverWorkspace.hpp"
 #include <queue>
 #include <climits>
 
 // Boost Graph 
 #include <boost/graph/adjacency_list.hpp>
 
-void calcDist(Graph& G, std::vector<bool>& visited, std::vector<int>& d, std::queue<Vertex>& currentVertices, int currentDist);
 
+// returns true if there is a path from the source node to the target node. a bfs over the
+// marks of [ws], it only touches the vertices it reaches
+bool checkVertexConnected(Graph& BG, Vertex source_vertex, Vertex target_vertex, SolverWorkspace& ws);
 
-// returns true if there is a path from the source to the target node by calling itself
-// only called by checkNodeConnected
-bool runCheckVertexConnected(Graph& BG, Vertex source_vertex, Vertex target_vertex, std::vector<bool>& visited);
+// the admissible arc search of the advance step with the out and in edges of i taken in turns.
+// returns false if i has no admissible arc, [scanned] counts the arcs it looked at
+bool interleavedAdmissibleArc(Graph& G, Vertex i, const std::vector<int>& d, Edge& arc, bool& isReal, long long& scanned);
 
-// returns true if there is a path from the source node to the target node
-bool checkVertexConnected(Graph& BG, Vertex source_vertex, Vertex target_vertex);
+bool interleavedArcScan = false;
 
 
 bool shortestAugmentedPath(Graph& G, Vertex s, Vertex t){
+    return shortestAugmentedPath(G, s, t, NULL, threadWorkspace());
+}
+
+bool shortestAugmentedPath(Graph& G, Vertex s, Vertex t, SapPhaseTimes* times){
+    return shortestAugmentedPath(G, s, t, times, threadWorkspace());
+}
+
+bool shortestAugmentedPath(Graph& G, Vertex s, Vertex t, SapPhaseTimes* times, SolverWorkspace& ws){
+
+    TRACE_SPAN("shortestAugmentedPath");
     
     bool PRINT_PROGRESS = false;
     const bool PRINT_DISTANCE = false;
@@ -59,7 +73,9 @@ bool shortestAugmentedPath(Graph& G, Vertex s, Vertex t){
     //     augment delta units of flow along path P
     // }
     
-    if (!(checkVertexConnected(G, s, t))){
+    ws.reserve(num_vertices(G), num_edges(G));
+
+    if (!(checkVertexConnected(G, s, t, ws))){
         std::cout<<"t is not reachable from s"<<std::endl;
         return false;
     }
@@ -81,19 +97,37 @@ bool shortestAugmentedPath(Graph& G, Vertex s, Vertex t){
         // G[*e_it].reversef = 0;
     }
 
-    // obtain exact distance labels d(i) using reverse bfs
-
-    std::vector<int> d(n, -1);
-    std::vector<bool> visited(n, false);
+    float phase_T = 0;
+    float augment_T = 0;
+    long long scanned = 0;
+    long long advances = 0;
+    long long advance_arcs = 0;
+    PerfReading phase_counters;
+
+    if (times){
+        times->dist = 0;
+        times->loop = 0;
+        times->augment = 0;
+        times->augmentations = 0;
+        threadTime(phase_T);
+        perfPhaseStart(phase_counters);
+    }
 
-    d[t] = 0;
+    // obtain exact distance labels d(i) using reverse bfs. d is -1 for every vertex of the
+    // workspace, so only the vertices the bfs reaches get a label
 
-    visited[t] = true;
+    std::vector<int>& d = ws.d;
 
-    std::queue<Vertex> currentVertices;
-    currentVertices.push(t);
+    {
+        TRACE_SPAN("sap distance labels");
+        calcDist(G, t, ws);
+    }
 
-    calcDist(G, visited, d, currentVertices, 0);
+    if (times){
+        times->dist = threadTime(phase_T);
+        times->distCounters = perfPhaseEnd(phase_counters);
+        perfPhaseStart(phase_counters);
+    }
 
     // print Vertex name and its distance
 
@@ -106,8 +140,11 @@ bool shortestAugmentedPath(Graph& G, Vertex s, Vertex t){
 
     Vertex i = s;
 
-    std::vector<Vertex> pred(n, t);
-    std::vector<bool> predIsReal(n, true);
+    // set on advance before they are read, only s retreats without having been advanced to
+    std::vector<Vertex>& pred = ws.pred;
+    std::vector<char>& predIsReal = ws.predIsReal;
+    pred[s] = t;
+    predIsReal[s] = true;
 
     int m = num_edges(G);
     int loop = 0;
@@ -139,70 +176,84 @@ bool shortestAugmentedPath(Graph& G, Vertex s, Vertex t){
         // revese edges in G_f using f. that way we can use all the out edges in G_f without having to modify G by adding and removing edges
         // similarly an out edge in G_f exists only if cap - f > 0 in G
 
-        // first search out edges
+        long long scan_start = scanned;
 
-        for (tie(out_e_it, out_e_it_end) = out_edges(i, G); out_e_it != out_e_it_end; out_e_it++){
-            Vertex j = target(*out_e_it, G);
+        if (interleavedArcScan){
+            arcFound = interleavedAdmissibleArc(G, i, d, admissibleArc, currPredIsReal, scanned);
+        }
+        else{
 
-            // ignore edges that cannot reach t
-            if (d[j] == -1) continue;
-            currPredIsReal = true;
-            // this arc is admissible
+            // first search out edges
 
-            if (PRINT_PROGRESS && (loop % ASK_FOR_INPUT_EVERY_LOOPS == 0)) {
-                std::cout<<"Looking for Admissible Arc: (i, j): "<<std::endl;
-                std::cout<<"d["<<G[i].name<<"] = "<<d[i]<<" d["<<G[j].name<<"] = "<<d[j]<<std::endl;
-                std::cout<<"cap ("<<G[i].name<<", "<<G[j].name<<"): "<<G[*out_e_it].cap<<" f ("<<G[i].name<<", "<<G[j].name<<"): "<<G[*out_e_it].f<<std::endl;
+            for (tie(out_e_it, out_e_it_end) = out_edges(i, G); out_e_it != out_e_it_end; out_e_it++){
+                Vertex j = target(*out_e_it, G);
+                scanned++;
 
-            }
+                // ignore edges that cannot reach t
+                if (d[j] == -1) continue;
+                currPredIsReal = true;
+                // this arc is admissible
 
-            // simulate the existence of an edge using cap - f
+                if (PRINT_PROGRESS && (loop % ASK_FOR_INPUT_EVERY_LOOPS == 0)) {
+                    std::cout<<"Looking for Admissible Arc: (i, j): "<<std::endl;
+                    std::cout<<"d["<<G[i].name<<"] = "<<d[i]<<" d["<<G[j].name<<"] = "<<d[j]<<std::endl;
+                    std::cout<<"cap ("<<G[i].name<<", "<<G[j].name<<"): "<<G[*out_e_it].cap<<" f ("<<G[i].name<<", "<<G[j].name<<"): "<<G[*out_e_it].f<<std::endl;
+
+                }
 
-            int r = G[*out_e_it].cap - G[*out_e_it].f;
+                // simulate the existence of an edge using cap - f
 
-            if ((d[i] == d[j] + 1) && r > 0){
+                int r = G[*out_e_it].cap - G[*out_e_it].f;
 
-                admissibleArc = *out_e_it;
-                arcFound = true;
-                break;
+                if ((d[i] == d[j] + 1) && r > 0){
+
+                    admissibleArc = *out_e_it;
+                    arcFound = true;
+                    break;
 
+                }
             }
-        }
 
-        // then in edges that simulate out edges
+            // then in edges that simulate out edges
 
-        if (!arcFound){
-            for (tie(in_e_it, in_e_it_end) = in_edges(i, G); in_e_it != in_e_it_end; in_e_it++){
-                Vertex j = source(*in_e_it, G);
+            if (!arcFound){
+                for (tie(in_e_it, in_e_it_end) = in_edges(i, G); in_e_it != in_e_it_end; in_e_it++){
+                    Vertex j = source(*in_e_it, G);
+                    scanned++;
                 
-                // ignore edges that cannot reach t
-                if (d[j] == -1) continue;
-                currPredIsReal = false;
+                    // ignore edges that cannot reach t
+                    if (d[j] == -1) continue;
+                    currPredIsReal = false;
                 
-                // this arc is admissible
+                    // this arc is admissible
 
-                if (PRINT_PROGRESS && (loop % ASK_FOR_INPUT_EVERY_LOOPS == 0)) {
-                    std::cout<<"Looking for Admissible Arc: (j, i): "<<std::endl;
-                    std::cout<<"d["<<G[i].name<<"] = "<<d[i]<<" d["<<G[j].name<<"] = "<<d[j]<<std::endl;
-                    std::cout<<"cap ("<<G[j].name<<", "<<G[i].name<<"): "<<G[*in_e_it].cap<<" f ("<<G[j].name<<", "<<G[i].name<<"): "<<G[*in_e_it].f<<std::endl;
+                    if (PRINT_PROGRESS && (loop % ASK_FOR_INPUT_EVERY_LOOPS == 0)) {
+                        std::cout<<"Looking for Admissible Arc: (j, i): "<<std::endl;
+                        std::cout<<"d["<<G[i].name<<"] = "<<d[i]<<" d["<<G[j].name<<"] = "<<d[j]<<std::endl;
+                        std::cout<<"cap ("<<G[j].name<<", "<<G[i].name<<"): "<<G[*in_e_it].cap<<" f ("<<G[j].name<<", "<<G[i].name<<"): "<<G[*in_e_it].f<<std::endl;
 
-                }
+                    }
 
-                // simulate the existence of an edge using f
+                    // simulate the existence of an edge using f
 
-                if ((d[i] == d[j] + 1) && G[*in_e_it].f > 0){
+                    if ((d[i] == d[j] + 1) && G[*in_e_it].f > 0){
 
-                    admissibleArc = *in_e_it;
-                    arcFound = true;
-                    break;
+                        admissibleArc = *in_e_it;
+                        arcFound = true;
+                        break;
 
+                    }
                 }
             }
+
         }
 
         // if arc found
         if (arcFound){
 
+            advances++;
+            advance_arcs += scanned - scan_start;
+
             // advance and augment
 
             if (PRINT_PROGRESS && (loop % ASK_FOR_INPUT_EVERY_LOOPS == 0)) std::cout<<"Admissible Arc found. admissibleArc: ("<<G[source(admissibleArc, G)].name<<", "<<G[target(admissibleArc, G)].name<<")"<<std::endl;
@@ -228,14 +279,20 @@ bool shortestAugmentedPath(Graph& G, Vertex s, Vertex t){
             // use pred to find identify the augmenting path P.
             // set f of all edges in path to min{r(ji) E P}
 
+            TRACE_SPAN("sap augment");
+
+            if (times) threadTime(augment_T);
+
             int delta = INT_MAX;
 
             if (PRINT_PROGRESS && (loop % ASK_FOR_INPUT_EVERY_LOOPS == 0)) std::cout<<"i == t. Augment."<<std::endl;
 
             // use pred to reach s and find min delta for arcs (j, i)
 
-            std::queue<Edge> pathEdges;
-            std::queue<bool> addFlow;
+            std::vector<Edge>& pathEdges = ws.pathEdges;
+            std::vector<char>& addFlow = ws.addFlow;
+            pathEdges.clear();
+            addFlow.clear();
 
             while (i != s){
 
@@ -261,8 +318,8 @@ bool shortestAugmentedPath(Graph& G, Vertex s, Vertex t){
 
                         if (PRINT_PROGRESS && (loop % ASK_FOR_INPUT_EVERY_LOOPS == 0)) std::cout<<"push edge: ("<<G[source(*in_e_it, G)].name<<", "<<G[target(*in_e_it, G)].name<<") cap: "<<G[*in_e_it].cap<<" f: "<<G[*in_e_it].f<<std::endl;
                         
-                        pathEdges.push(*in_e_it);
-                        addFlow.push(true);
+                        pathEdges.push_back(*in_e_it);
+                        addFlow.push_back(true);
 
                         if (r < delta){
                             delta = r;
@@ -282,8 +339,8 @@ bool shortestAugmentedPath(Graph& G, Vertex s, Vertex t){
                         if (PRINT_PROGRESS && (loop % ASK_FOR_INPUT_EVERY_LOOPS == 0)) std::cout<<"push reverse edge: ("<<G[source(*out_e_it, G)].name<<", "<<G[target(*out_e_it, G)].name<<") cap: "<<G[*out_e_it].cap<<" f: "<<G[*out_e_it].f<<std::endl;
                         // if (PRINT_PROGRESS && (loop % ASK_FOR_INPUT_EVERY_LOOPS == 0)) std::cout<<"push reverse edge: ("<<G[source(*out_e_it, G)].name<<", "<<G[target(*out_e_it, G)].name<<") reversef: "<<G[*out_e_it].reversef<<std::endl;
 
-                        pathEdges.push(*out_e_it);
-                        addFlow.push(false);
+                        pathEdges.push_back(*out_e_it);
+                        addFlow.push_back(false);
 
                         int r = G[*out_e_it].f;
 
@@ -303,13 +360,12 @@ bool shortestAugmentedPath(Graph& G, Vertex s, Vertex t){
 
             // augment edges
 
-            while (!pathEdges.empty()){
-                Edge e = pathEdges.front();
-                pathEdges.pop();
+            for (size_t p = 0; p < pathEdges.size(); p++){
+                Edge e = pathEdges[p];
                 
                 if (PRINT_PROGRESS && (loop % ASK_FOR_INPUT_EVERY_LOOPS == 0)) std::cout<<"Augmenting Edge: ("<<G[source(e, G)].name<<", "<<G[target(e, G)].name<<") flow: "<<G[e].f<<std::endl;
                 
-                if (addFlow.front()){
+                if (addFlow[p]){
                     G[e].f += delta;
                     // G[e].reversef += delta;
                 }
@@ -317,12 +373,16 @@ bool shortestAugmentedPath(Graph& G, Vertex s, Vertex t){
                     G[e].f -= delta;
                     // G[e].reversef -= delta;
                 }
-                addFlow.pop();
 
             }
 
             i = s;
 
+            if (times){
+                times->augment += threadTime(augment_T);
+                times->augmentations++;
+            }
+
         }
         else{
 
@@ -341,11 +401,17 @@ bool shortestAugmentedPath(Graph& G, Vertex s, Vertex t){
             if (predIsReal[i]){
 
                 for (tie(in_e_it, in_e_it_end) = in_edges(i, G); in_e_it != in_e_it_end; in_e_it++){
+                    scanned++;
                     if (PRINT_PROGRESS && (loop % ASK_FOR_INPUT_EVERY_LOOPS == 0)) std::cout<<"in edge: ("<<G[source(*in_e_it, G)].name<<", "<<G[target(*in_e_it, G)].name<<") cap: "<<G[*in_e_it].cap<<" f: "<<G[*in_e_it].f<<std::endl;
                     
                     if (!(G[*in_e_it].f > 0)) continue;
     
-                    int newD = d[source(*out_e_it, G)] + 1;
+                    // this used to read the source of the out edge iterator the advance step left at
+                    // the end of the list of i, which is i, so d[i] went up by one. the interleaved
+                    // scan does not set that iterator. the min over the in edges alone can be above
+                    // what an out edge allows and stop SAP before the flow is maximum, so the step
+                    // stays one
+                    int newD = d[i] + 1;
     
                     if (newD == 0) continue;
     
@@ -361,6 +427,7 @@ bool shortestAugmentedPath(Graph& G, Vertex s, Vertex t){
             else{
                 
                 for (tie(out_e_it, out_e_it_end) = out_edges(i, G); out_e_it != out_e_it_end; out_e_it++){
+                    scanned++;
     
                     if (PRINT_PROGRESS && (loop % ASK_FOR_INPUT_EVERY_LOOPS == 0)) std::cout<<"out edge: ("<<G[source(*out_e_it, G)].name<<", "<<G[target(*out_e_it, G)].name<<") cap: "<<G[*out_e_it].cap<<" f: "<<G[*out_e_it].f<<std::endl;
     
@@ -418,6 +485,15 @@ bool shortestAugmentedPath(Graph& G, Vertex s, Vertex t){
         
     }
 
+    // the loop time does not include the augment steps
+    if (times){
+        times->loop = threadTime(phase_T) - times->augment;
+        times->loopCounters = perfPhaseEnd(phase_counters);
+        times->arcsScanned = scanned;
+        times->advances = advances;
+        times->advanceArcs = advance_arcs;
+    }
+
     // print Vertex name and its distance
 
     if (PRINT_PROGRESS && (loop % ASK_FOR_INPUT_EVERY_LOOPS == 0)){
@@ -427,80 +503,123 @@ bool shortestAugmentedPath(Graph& G, Vertex s, Vertex t){
 
     }
 
+    // the labelled vertices are the ones the bfs found, put d back to -1 for the next call
+    for (size_t q = 0; q < ws.queue.size(); q++){
+        d[ws.queue[q]] = -1;
+    }
+
     return true;
     
 }
 
+void setInterleavedArcScan(bool interleaved){
+    interleavedArcScan = interleaved;
+}
+
+bool interleavedAdmissibleArc(Graph& G, Vertex i, const std::vector<int>& d, Edge& arc, bool& isReal, long long& scanned){
+
+    OutEdgeIterator out_e_it, out_e_it_end;
+    InEdgeIterator in_e_it, in_e_it_end;
+
+    tie(out_e_it, out_e_it_end) = out_edges(i, G);
+    tie(in_e_it, in_e_it_end) = in_edges(i, G);
+
+    while (out_e_it != out_e_it_end || in_e_it != in_e_it_end){
+
+        // an out edge with cap - f > 0
+        if (out_e_it != out_e_it_end){
+            Vertex j = target(*out_e_it, G);
+            scanned++;
+
+            if (d[j] != -1 && d[i] == d[j] + 1 && G[*out_e_it].cap - G[*out_e_it].f > 0){
+                arc = *out_e_it;
+                isReal = true;
+                return true;
+            }
+            out_e_it++;
+        }
+
+        // an in edge with f > 0, the reverse arc
+        if (in_e_it != in_e_it_end){
+            Vertex j = source(*in_e_it, G);
+            scanned++;
+
+            if (d[j] != -1 && d[i] == d[j] + 1 && G[*in_e_it].f > 0){
+                arc = *in_e_it;
+                isReal = false;
+                return true;
+            }
+            in_e_it++;
+        }
+
+    }
+
+    return false;
+
+}
+
 // calculates the exact distance labels for each vertex and stores them in d
 
-void calcDist(Graph& G, std::vector<bool>& visited, std::vector<int>& d, std::queue<Vertex>& currentVertices, int currentDist){
-    
+void calcDist(Graph& G, Vertex t, SolverWorkspace& ws){
+
     InEdgeIterator in_e_it, in_e_it_end;
-    std::queue<Vertex> nextVertices;
-    currentDist++;
 
-    while (!currentVertices.empty()){
+    std::vector<int>& d = ws.d;
+    std::vector<Vertex>& queue = ws.queue;
+
+    ws.newEpoch();
+    queue.clear();
 
-        Vertex y = currentVertices.front();
-        currentVertices.pop();
+    d[t] = 0;
+    ws.mark(t);
+    queue.push_back(t);
 
-        // if (y == s) continue;
+    // the queue is not popped, afterwards it holds every vertex that got a label
+    for (size_t q = 0; q < queue.size(); q++){
 
-        // std::cout<<"curr vertex: "<<G[y].name<<std::endl;
+        Vertex y = queue[q];
 
         for (tie(in_e_it, in_e_it_end) = in_edges(y, G); in_e_it != in_e_it_end; in_e_it++){
-            
+
             Vertex i = source(*in_e_it, G);
-            // std::cout<< "now checking source i: "<<G[i].name<<std::endl;
 
-            if (visited[i]){
-                // std::cout<<G[i].name<<" is already visited"<<std::endl;
-                continue;
-            } 
-            
-            visited[i] = true;
-            d[i] = currentDist;
-            nextVertices.push(i);
-
-            // std::cout<<"visited["<<G[i].name<<"] = true dist: "<<d[i]<<std::endl;
-            
+            if (ws.marked(i)) continue;
+
+            ws.mark(i);
+            d[i] = d[y] + 1;
+            queue.push_back(i);
+
         }
-        
-    }
-    while(!nextVertices.empty()){
-        calcDist(G, visited, d, nextVertices, currentDist);
+
     }
-    
+
 }
 
+// returns true if there is a path from the source node to the target node
+bool checkVertexConnected(Graph& BG, Vertex source_vertex, Vertex target_vertex, SolverWorkspace& ws){
 
-// returns true if there is a path from the source to the target node by calling itself
-// only called by checkNodeConnected
-bool runCheckVertexConnected(Graph& BG, Vertex source_vertex, Vertex target_vertex, std::vector<bool>& visited){
-    if (source_vertex == target_vertex) return true;
-    if (visited[source_vertex]) return false;
-    visited[source_vertex] = true;
     OutEdgeIterator out_e_it, out_e_it_end;
 
-    for (tie(out_e_it, out_e_it_end) = out_edges(source_vertex, BG); out_e_it != out_e_it_end; out_e_it++){
-        Vertex v = target(*out_e_it, BG);
-        if (runCheckVertexConnected(BG, v, target_vertex, visited)) return true;
+    std::vector<Vertex>& queue = ws.queue;
+
+    ws.newEpoch();
+    queue.clear();
+
+    ws.mark(source_vertex);
+    queue.push_back(source_vertex);
+
+    for (size_t q = 0; q < queue.size(); q++){
+        Vertex v = queue[q];
+        if (v == target_vertex) return true;
+
+        for (tie(out_e_it, out_e_it_end) = out_edges(v, BG); out_e_it != out_e_it_end; out_e_it++){
+            Vertex w = target(*out_e_it, BG);
+            if (ws.marked(w)) continue;
+            ws.mark(w);
+            queue.push_back(w);
+        }
     }
-    return false;
 
-    // forall_out_edges(e, source_vertex){
-    //     leda::node v = LG.target(e);
-    //     if (runCheckNodeConnected(LG, v, target_vertex, visited)) return true;
-    // }
-    // return false;
-}
+    return false;
 
-// returns true if there is a path from the source node to the target node
-bool checkVertexConnected(Graph& BG, Vertex source_vertex, Vertex target_vertex){
-    
-    std::vector<bool> visited(num_vertices(BG), false);
-    
-    return runCheckVertexConnected(BG, source_vertex, target_vertex, visited);
-    
 }
-
@@ -0,0 +1,239 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include "boostGraphStruct.hpp"
+#include "solverDispatch.hpp"
+#include "shortestAugmentedPath.hpp"
+#include "flatShortestAugmentedPath.hpp"
+#include "boostBaselines.hpp"
+#include "bipartiteMatching.hpp"
+#include "planarGridFlow.hpp"
+#include "regionMaxFlow.hpp"
+#include "compressedNetwork.hpp"
+#include <climits>
+#include <mutex>
+
+using namespace boost;
+
+// graphs with a larger density are dense
+const double DENSE_DENSITY = 0.05;
+
+// graphs where the largest degree is this many times the mean degree are skewed
+const double SKEWED_DEGREE = 20;
+
+std::string calibrationFile = "dispatch.calibration";
+std::vector<CalibrationEntry> calibration;
+bool calibrationRead = false;
+std::mutex calibrationMutex;   // the table is read on the first dispatch, which may be on any thread
+bool dispatchLog = true;
+
+// the solver called [name], NULL if there is none
+const DispatchSolver* findDispatchSolver(const std::string& name);
+
+
+void graphStatistics(Graph& G, Vertex s, Vertex t, GraphStatistics& stats){
+    BipartiteNetwork B;
+    PlanarGrid P;
+    graphStatistics(G, s, t, stats, B, P);
+}
+
+void graphStatistics(Graph& G, Vertex s, Vertex t, GraphStatistics& stats, BipartiteNetwork& B, PlanarGrid& P){
+
+    EdgeIterator e_it, e_it_end;
+    VertexIterator v_it, v_it_end;
+
+    stats.n = num_vertices(G);
+    stats.m = num_edges(G);
+    stats.density = stats.n > 1 ? (double)stats.m / ((double)stats.n * (stats.n - 1)) : 0;
+
+    stats.minCap = INT_MAX;
+    stats.maxCap = 0;
+
+    for (tie(e_it, e_it_end) = edges(G); e_it != e_it_end; e_it++){
+        int cap = G[*e_it].cap;
+        if (cap < stats.minCap) stats.minCap = cap;
+        if (cap > stats.maxCap) stats.maxCap = cap;
+    }
+    if (stats.m == 0) stats.minCap = 0;
+
+    stats.maxDegree = 0;
+    for (tie(v_it, v_it_end) = vertices(G); v_it != v_it_end; v_it++){
+        int degree = in_degree(*v_it, G) + out_degree(*v_it, G);
+        if (degree > stats.maxDegree) stats.maxDegree = degree;
+    }
+
+    double meanDegree = stats.n > 0 ? 2.0 * stats.m / stats.n : 0;
+    stats.degreeSkew = meanDegree > 0 ? stats.maxDegree / meanDegree : 0;
+
+    stats.unitCapacity = stats.m > 0 && stats.minCap == 1 && stats.maxCap == 1;
+
+    // the structure checks are only run when the cheap numbers allow them
+    stats.bipartite = stats.unitCapacity && buildBipartiteNetwork(G, s, t, B);
+
+    stats.grid = !stats.bipartite && recognizePlanarGrid(G, s, t, P);
+
+}
+
+std::string graphClass(const GraphStatistics& stats){
+
+    if (stats.bipartite) return "bipartite";
+    if (stats.grid) return "grid";
+    if (stats.density > DENSE_DENSITY) return "dense";
+    if (stats.degreeSkew > SKEWED_DEGREE) return "skewed";
+    return "sparse";
+
+}
+
+const std::vector<DispatchSolver>& dispatchSolvers(){
+
+    static std::vector<DispatchSolver> solvers;
+
+    if (solvers.empty()){
+        solvers.push_back({"shortestAugmentedPath", shortestAugmentedPath, ""});
+        solvers.push_back({"flatShortestAugmentedPath", flatShortestAugmentedPath, ""});
+        solvers.push_back({"boostEdmondsKarp", boostEdmondsKarp, ""});
+        solvers.push_back({"boostPushRelabel", boostPushRelabel, ""});
+        solvers.push_back({"boostBoykovKolmogorov", boostBoykovKolmogorov, ""});
+        solvers.push_back({"regionMaxFlow", regionMaxFlow, ""});
+        solvers.push_back({"compressedShortestAugmentedPath", compressedShortestAugmentedPath, ""});
+        // on other classes these two only add their structure check to flatShortestAugmentedPath
+        solvers.push_back({"bipartiteMaxFlow", bipartiteMaxFlow, "bipartite"});
+        solvers.push_back({"planarGridMaxFlow", planarGridMaxFlow, "grid"});
+    }
+
+    return solvers;
+
+}
+
+bool solverFitsClass(const DispatchSolver& solver, const std::string& graphClass){
+    return solver.onlyClass.empty() || solver.onlyClass == graphClass;
+}
+
+bool readCalibration(const std::string& path, std::vector<CalibrationEntry>& table){
+
+    std::ifstream in(path.c_str());
+    if (!in) return false;
+
+    table.clear();
+
+    std::string line;
+    while (std::getline(in, line)){
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream fields(line);
+        CalibrationEntry entry;
+        if (fields >> entry.graphClass >> entry.solver >> entry.nsPerEdge) table.push_back(entry);
+    }
+
+    return true;
+
+}
+
+bool writeCalibration(const std::string& path, const std::vector<CalibrationEntry>& table){
+
+    std::ofstream out(path.c_str());
+    if (!out) return false;
+
+    out<<"# class solver nsPerEdge"<<std::endl;
+
+    for (size_t k = 0; k < table.size(); k++){
+        out<<table[k].graphClass<<" "<<table[k].solver<<" "<<table[k].nsPerEdge<<std::endl;
+    }
+
+    return true;
+
+}
+
+void setCalibrationFile(const std::string& path){
+    std::lock_guard<std::mutex> lock(calibrationMutex);
+    calibrationFile = path;
+    calibrationRead = false;
+}
+
+void setDispatchLog(bool log){
+    dispatchLog = log;
+}
+
+const DispatchSolver& chooseSolver(const GraphStatistics& stats, std::string& reason){
+
+    // held while the table is used, so that setCalibrationFile cannot reload it underneath
+    std::lock_guard<std::mutex> lock(calibrationMutex);
+
+    if (!calibrationRead){
+        if (!readCalibration(calibrationFile, calibration)) calibration.clear();
+        calibrationRead = true;
+    }
+
+    std::string cls = graphClass(stats);
+    std::stringstream why;
+
+    // fastest and second fastest calibrated solver of the class
+    const CalibrationEntry* best = NULL;
+    const CalibrationEntry* second = NULL;
+
+    for (size_t k = 0; k < calibration.size(); k++){
+        const CalibrationEntry& entry = calibration[k];
+        const DispatchSolver* solver = findDispatchSolver(entry.solver);
+        if (entry.graphClass != cls || !solver || !solverFitsClass(*solver, cls)) continue;
+
+        if (!best || entry.nsPerEdge < best->nsPerEdge){
+            second = best;
+            best = &entry;
+        }
+        else if (!second || entry.nsPerEdge < second->nsPerEdge) second = &entry;
+    }
+
+    if (best){
+        why<<"class "<<cls<<", "<<best->nsPerEdge<<" ns/edge in "<<calibrationFile;
+        why<<", expected "<<best->nsPerEdge * stats.m * 1e-9<<" seconds";
+        if (second) why<<" (next "<<second->solver<<" "<<second->nsPerEdge<<" ns/edge)";
+        reason = why.str();
+        return *findDispatchSolver(best->solver);
+    }
+
+    // not calibrated, the specialised solvers for their classes and the flat solver otherwise
+    std::string name = "flatShortestAugmentedPath";
+    if (cls == "bipartite") name = "bipartiteMaxFlow";
+    else if (cls == "grid") name = "planarGridMaxFlow";
+
+    why<<"class "<<cls<<" is not in "<<calibrationFile<<", default choice";
+    reason = why.str();
+    return *findDispatchSolver(name);
+
+}
+
+bool dispatchMaxFlow(Graph& G, Vertex s, Vertex t){
+
+    GraphStatistics stats;
+    BipartiteNetwork B;
+    PlanarGrid P;
+    graphStatistics(G, s, t, stats, B, P);
+
+    std::string reason;
+    const DispatchSolver& picked = chooseSolver(stats, reason);
+
+    if (dispatchLog){
+        std::cout<<"dispatch: n "<<stats.n<<" m "<<stats.m<<" density "<<stats.density;
+        std::cout<<" cap ["<<stats.minCap<<", "<<stats.maxCap<<"] degree skew "<<stats.degreeSkew;
+        std::cout<<" -> "<<picked.name<<": "<<reason<<std::endl;
+    }
+
+    // the structure is already known, so the specialised solvers do not look for it again
+    if (picked.name == "bipartiteMaxFlow" && stats.bipartite) return bipartiteMaxFlow(G, B);
+    if (picked.name == "planarGridMaxFlow" && stats.grid) return planarGridMaxFlow(G, P);
+
+    return picked.solver(G, s, t);
+
+}
+
+const DispatchSolver* findDispatchSolver(const std::string& name){
+
+    const std::vector<DispatchSolver>& solvers = dispatchSolvers();
+
+    for (size_t k = 0; k < solvers.size(); k++){
+        if (solvers[k].name == name) return &solvers[k];
+    }
+
+    return NULL;
+
+}
@@ -0,0 +1,22 @@
+#include "boostGraphStruct.hpp"
+#include "solverWorkspace.hpp"
+
+void SolverWorkspace::reserve(int n, int m){
+
+    if ((int)stamp.size() < n){
+        stamp.resize(n, 0);
+        d.resize(n, -1);
+        pred.resize(n);
+        predIsReal.resize(n);
+    }
+
+    queue.reserve(n);
+    pathEdges.reserve(std::min(n, m));
+    addFlow.reserve(std::min(n, m));
+
+}
+
+SolverWorkspace& threadWorkspace(){
+    static thread_local SolverWorkspace workspace;
+    return workspace;
+}
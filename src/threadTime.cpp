@@ -0,0 +1,16 @@
+#include "threadTime.hpp"
+
+#include <time.h>
+
+float threadTime(){
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (float)ts.tv_sec + (float)ts.tv_nsec / 1e9f;
+}
+
+float threadTime(float& start_T){
+    float now = threadTime();
+    float elapsed = now - start_T;
+    start_T = now;
+    return elapsed;
+}
@@ -0,0 +1,146 @@
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include "traceSpans.hpp"
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include <memory>
+
+struct TraceEvent
+{
+    const char* name;
+    int64_t start;
+    int64_t end;
+};
+
+// spans of one thread. only the thread writes it, writeTrace reads it after the thread stopped
+struct TraceBuffer
+{
+    int tid;
+    std::string name;
+    std::vector<TraceEvent> events;
+    long long recorded;         // all spans ever recorded, the last ones are in events
+};
+
+std::mutex traceMutex;
+std::vector<std::unique_ptr<TraceBuffer> > traceBuffers;    // kept after their thread ends
+thread_local TraceBuffer* threadTrace = NULL;
+
+// the buffer of the calling thread, made on its first span
+TraceBuffer& traceBuffer();
+
+// writes [text] as a JSON string
+void writeJsonString(std::ostream& out, const std::string& text);
+
+
+int64_t traceNow(){
+
+    static const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+
+}
+
+void traceRecord(const char* name, int64_t start, int64_t end){
+
+    TraceBuffer& buffer = traceBuffer();
+
+    TraceEvent event = {name, start, end};
+
+    if ((int)buffer.events.size() < TRACE_EVENTS_PER_THREAD) buffer.events.push_back(event);
+    else buffer.events[buffer.recorded % TRACE_EVENTS_PER_THREAD] = event;
+
+    buffer.recorded++;
+
+}
+
+void traceThreadName(const std::string& name){
+    traceBuffer().name = name;
+}
+
+bool writeTrace(const std::string& path){
+
+    std::ofstream out(path.c_str());
+    if (!out) return false;
+
+    std::lock_guard<std::mutex> lock(traceMutex);
+
+    long long events = 0;
+    long long dropped = 0;
+    bool first = true;
+
+    // ts and dur are microseconds with the nanoseconds as three decimals, the default six
+    // significant digits would round the start of a span after the first second
+    out<<std::fixed<<std::setprecision(3);
+
+    out<<"{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+    for (size_t b = 0; b < traceBuffers.size(); b++){
+        const TraceBuffer& buffer = *traceBuffers[b];
+
+        if (!buffer.name.empty()){
+            out<<(first ? "" : ",\n")<<"{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"<<buffer.tid<<",\"args\":{\"name\":";
+            writeJsonString(out, buffer.name);
+            out<<"}}";
+            first = false;
+        }
+
+        // complete events with microsecond times
+        for (size_t k = 0; k < buffer.events.size(); k++){
+            const TraceEvent& event = buffer.events[k];
+            out<<(first ? "" : ",\n")<<"{\"name\":";
+            writeJsonString(out, event.name);
+            out<<",\"ph\":\"X\",\"pid\":1,\"tid\":"<<buffer.tid<<",\"ts\":"<<event.start / 1000.0<<",\"dur\":"<<(event.end - event.start) / 1000.0<<"}";
+            first = false;
+        }
+
+        events += buffer.events.size();
+        dropped += buffer.recorded - buffer.events.size();
+    }
+
+    out<<"\n]}\n";
+
+    std::cout<<"Trace: "<<events<<" spans of "<<traceBuffers.size()<<" threads written to "<<path;
+    if (dropped > 0) std::cout<<", "<<dropped<<" older spans were overwritten";
+    std::cout<<std::endl;
+
+    return (bool)out;
+
+}
+
+bool traceCompiledIn(){
+#ifdef ADST_TRACE
+    return true;
+#else
+    return false;
+#endif
+}
+
+TraceBuffer& traceBuffer(){
+
+    if (!threadTrace){
+        std::lock_guard<std::mutex> lock(traceMutex);
+        traceBuffers.push_back(std::unique_ptr<TraceBuffer>(new TraceBuffer));
+        threadTrace = traceBuffers.back().get();
+        threadTrace->tid = traceBuffers.size();
+        threadTrace->recorded = 0;
+        threadTrace->events.reserve(1024);
+    }
+
+    return *threadTrace;
+
+}
+
+void writeJsonString(std::ostream& out, const std::string& text){
+
+    out<<'"';
+    for (size_t k = 0; k < text.size(); k++){
+        char c = text[k];
+        if (c == '"' || c == '\\') out<<'\\'<<c;
+        else if ((unsigned char)c < 0x20) out<<' ';
+        else out<<c;
+    }
+    out<<'"';
+
+}
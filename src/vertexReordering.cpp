@@ -0,0 +1,224 @@
+#include "boostGraphStruct.hpp"
+#include "vertexReordering.hpp"
+#include <algorithm>
+
+using namespace boost;
+
+// appends to [order] the vertices discovered by a bfs from [start] over in edges
+void reverseBFSOrder(Graph& G, Vertex start, std::vector<bool>& visited, std::vector<Vertex>& order);
+
+// appends to [order] the Cuthill-McKee order of the component of [start] on the undirected view of G
+void cuthillMcKeeOrder(Graph& G, Vertex start, std::vector<bool>& visited, std::vector<Vertex>& order);
+
+// returns a vertex of low degree far away from [start] in the component of [start].
+// [level] must be all -1 and is left that way
+Vertex pseudoPeripheralVertex(Graph& G, Vertex start, std::vector<int>& level);
+
+// the neighbours of v in the undirected view of G
+void undirectedNeighbours(Graph& G, Vertex v, std::vector<Vertex>& neighbours);
+
+
+void computeVertexOrder(Graph& G, Vertex t, VertexOrder vertexOrder, std::vector<Vertex>& order){
+
+    int n = num_vertices(G);
+
+    order.clear();
+    order.reserve(n);
+
+    if (vertexOrder == ORDER_NONE){
+        for (int v = 0; v < n; v++){
+            order.push_back(v);
+        }
+        return;
+    }
+
+    std::vector<bool> visited(n, false);
+
+    if (vertexOrder == ORDER_REVERSE_BFS){
+
+        reverseBFSOrder(G, t, visited, order);
+
+        // vertices that cannot reach t keep their relative order at the end
+        for (int v = 0; v < n; v++){
+            if (!visited[v]) order.push_back(v);
+        }
+
+    }
+    else{
+
+        // one Cuthill-McKee order per component, starting with the component of t
+        std::vector<int> level(n, -1);
+
+        cuthillMcKeeOrder(G, pseudoPeripheralVertex(G, t, level), visited, order);
+        for (int v = 0; v < n; v++){
+            if (!visited[v]) cuthillMcKeeOrder(G, pseudoPeripheralVertex(G, v, level), visited, order);
+        }
+
+        std::reverse(order.begin(), order.end());
+
+    }
+
+}
+
+void reorderVertices(Graph& G, Vertex s, Vertex t, VertexOrder vertexOrder, ReorderedGraph& R){
+
+    int n = num_vertices(G);
+
+    OutEdgeIterator out_e_it, out_e_it_end;
+
+    computeVertexOrder(G, t, vertexOrder, R.originalVertex);
+
+    std::vector<Vertex> newVertex(n);
+    for (int k = 0; k < n; k++){
+        newVertex[R.originalVertex[k]] = k;
+    }
+
+    R.G.clear();
+    R.edgeMap.clear();
+    R.edgeMap.reserve(num_edges(G));
+
+    for (int k = 0; k < n; k++){
+        Vertex v = add_vertex(R.G);
+        R.G[v].name = G[R.originalVertex[k]].name;
+    }
+
+    // add the edges source by source in the new order
+
+    for (int k = 0; k < n; k++){
+        Vertex v = R.originalVertex[k];
+
+        for (tie(out_e_it, out_e_it_end) = out_edges(v, G); out_e_it != out_e_it_end; out_e_it++){
+            Edge e = add_edge(k, newVertex[target(*out_e_it, G)], R.G).first;
+            R.G[e].cap = G[*out_e_it].cap;
+            R.G[e].f = G[*out_e_it].f;
+            R.edgeMap.push_back(std::make_pair(*out_e_it, e));
+        }
+    }
+
+    R.s = newVertex[s];
+    R.t = newVertex[t];
+
+}
+
+void expandReorderedFlow(Graph& G, const ReorderedGraph& R){
+
+    for (size_t k = 0; k < R.edgeMap.size(); k++){
+        G[R.edgeMap[k].first].f = R.G[R.edgeMap[k].second].f;
+    }
+
+}
+
+
+void reverseBFSOrder(Graph& G, Vertex start, std::vector<bool>& visited, std::vector<Vertex>& order){
+
+    InEdgeIterator in_e_it, in_e_it_end;
+
+    size_t head = order.size();
+    order.push_back(start);
+    visited[start] = true;
+
+    // order doubles as the bfs queue
+    while (head < order.size()){
+        Vertex y = order[head++];
+
+        for (tie(in_e_it, in_e_it_end) = in_edges(y, G); in_e_it != in_e_it_end; in_e_it++){
+            Vertex i = source(*in_e_it, G);
+            if (visited[i]) continue;
+            visited[i] = true;
+            order.push_back(i);
+        }
+    }
+
+}
+
+void cuthillMcKeeOrder(Graph& G, Vertex start, std::vector<bool>& visited, std::vector<Vertex>& order){
+
+    std::vector<Vertex> neighbours;
+    std::vector<std::pair<int, Vertex> > byDegree;
+
+    size_t head = order.size();
+    order.push_back(start);
+    visited[start] = true;
+
+    while (head < order.size()){
+        Vertex y = order[head++];
+
+        undirectedNeighbours(G, y, neighbours);
+
+        // unvisited neighbours are queued by increasing degree
+        byDegree.clear();
+        for (size_t k = 0; k < neighbours.size(); k++){
+            Vertex w = neighbours[k];
+            if (visited[w]) continue;
+            visited[w] = true;
+            byDegree.push_back(std::make_pair((int)(out_degree(w, G) + in_degree(w, G)), w));
+        }
+        std::sort(byDegree.begin(), byDegree.end());
+
+        for (size_t k = 0; k < byDegree.size(); k++){
+            order.push_back(byDegree[k].second);
+        }
+    }
+
+}
+
+Vertex pseudoPeripheralVertex(Graph& G, Vertex start, std::vector<int>& level){
+
+    std::vector<Vertex> queue;
+    std::vector<Vertex> neighbours;
+
+    Vertex current = start;
+    int eccentricity = -1;
+
+    // repeat bfs from the lowest degree vertex of the last level until the eccentricity stops growing
+    while (true){
+
+        queue.clear();
+        queue.push_back(current);
+        level[current] = 0;
+
+        for (size_t head = 0; head < queue.size(); head++){
+            Vertex y = queue[head];
+            undirectedNeighbours(G, y, neighbours);
+            for (size_t k = 0; k < neighbours.size(); k++){
+                if (level[neighbours[k]] != -1) continue;
+                level[neighbours[k]] = level[y] + 1;
+                queue.push_back(neighbours[k]);
+            }
+        }
+
+        int lastLevel = level[queue.back()];
+
+        Vertex best = queue.back();
+        for (size_t k = queue.size(); k-- > 0 && level[queue[k]] == lastLevel; ){
+            if (out_degree(queue[k], G) + in_degree(queue[k], G) < out_degree(best, G) + in_degree(best, G)){
+                best = queue[k];
+            }
+        }
+
+        for (size_t k = 0; k < queue.size(); k++){
+            level[queue[k]] = -1;
+        }
+
+        if (lastLevel <= eccentricity) return current;
+        eccentricity = lastLevel;
+        current = best;
+    }
+
+}
+
+void undirectedNeighbours(Graph& G, Vertex v, std::vector<Vertex>& neighbours){
+
+    OutEdgeIterator out_e_it, out_e_it_end;
+    InEdgeIterator in_e_it, in_e_it_end;
+
+    neighbours.clear();
+
+    for (tie(out_e_it, out_e_it_end) = out_edges(v, G); out_e_it != out_e_it_end; out_e_it++){
+        neighbours.push_back(target(*out_e_it, G));
+    }
+    for (tie(in_e_it, in_e_it_end) = in_edges(v, G); in_e_it != in_e_it_end; in_e_it++){
+        neighbours.push_back(source(*in_e_it, G));
+    }
+
+}